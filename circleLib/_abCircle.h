@@ -5,15 +5,20 @@
 
 /** AbShape circle
  *  
- *  chords should be a vector of length radius + 1.  
- *  Entry at index i is 1/2 chord length at distance i from the circle's center.  
- *  This vector can be generated using lcdLib's computeChordVec() (lcddraw.h).
+ *  chords should be a vector of length radius + 1.  Entry at index i
+ *  is 1/2 chord length at distance i from the circle's center.  Up to
+ *  octant (the 45 degree point, where chords[i] >= i) they are the 
+ *  first octant's chords; beyond it, the second octant's map from
+ *  column to row.  Either way every row's chord is a direct index.
+ *  makeCircles generates them using computeChordVec().
  */ 
 typedef struct AbCircle_s {
   void (*getBounds)(const struct AbCircle_s *circle, const Vec2 *centerPos, Region *bounds);
   int (*check)(const struct AbCircle_s *circle, const Vec2 *centerPos, const Vec2 *pixel);
+  void (*rowSpans)(const struct AbCircle_s *circle, const Vec2 *centerPos, int row, SpanFn emit, void *ctx);
   const u_char *chords;
   const u_char radius;
+  const u_char octant;		/**< last index of the first octant */
 } AbCircle;
 
 /** Required by AbShape
@@ -24,6 +29,69 @@ void abCircleGetBounds(const AbCircle *circle, const Vec2 *circlePos, Region *bo
  */
 int abCircleCheck(const AbCircle *circle, const Vec2 *circlePos, const Vec2 *pixel);
 
+/** Required by AbShape
+ */
+void abCircleRowSpans(const AbCircle *circle, const Vec2 *circlePos, int row, SpanFn emit, void *ctx);
+
+/** 1/2 chord length at distance dist (<= radius) from the circle's center
+ *  (a direct index of its chords)
+ */
+u_char abCircleChord(const AbCircle *circle, u_char dist);
+
+/** Fill circle centered at col,row directly (without layers): 
+ *  one lcd span per row, read from the circle's chords.
+ *  Clipped to the screen.
+ */
+void fillCircle(int col, int row, const AbCircle *circle, u_int colorBGR);
+
+/** Fill the ring between inner and outer (inner->radius < outer->radius)
+ *  centered at col,row.  The hole is left untouched.  At most two 
+ *  lcd spans per row.  Clipped to the screen.
+ */
+void fillRing(int col, int row, const AbCircle *inner, const AbCircle *outer, 
+	      u_int colorBGR);
+
+/** Contact between a circle and another shape
+ *
+ *  normal: direction (each axis -1, 0 or 1) in which to move the circle
+ *  out of the contact.  depth: pixels to move it that way (>= 1).
+ */
+typedef struct {
+  Vec2 normal;
+  int depth;
+} Contact;
+
+/** True if circle at circlePos shares a pixel with rect at rectPos.
+ *  Exact (uses the circle's chords).  Fills contact if so; its normal is 
+ *  along the axis the circle reaches least far past the rect (diagonal 
+ *  if equal).
+ */
+int circleRectCollide(const AbCircle *circle, const Vec2 *circlePos, 
+		      const AbRect *rect, const Vec2 *rectPos, Contact *contact);
+
+/** True if circles a and b share a pixel (tested row by row).  Fills 
+ *  contact for moving a: its normal is the nearest of 8 directions from 
+ *  b's center to a's; depth approximates the circles' overlap (exact 
+ *  along axes).
+ */
+int circleCircleCollide(const AbCircle *a, const Vec2 *aPos, 
+			const AbCircle *b, const Vec2 *bPos, Contact *contact);
+
+/** True if circle at circlePos extends beyond fence (e.g. the bounds of
+ *  an AbRectOutline).  Fills contact: normal points back inside on each 
+ *  axis crossed; depth is the farthest the circle extends past.
+ */
+int circleFenceCollide(const AbCircle *circle, const Vec2 *circlePos, 
+		       const Region *fence, Contact *contact);
+
+/** Swept circleRectCollide: true if circle at circlePos, displaced by
+ *  velocity over one step, comes to share a pixel with rect (which is 
+ *  not moving, or pass velocity relative to it).  Fills hit as 
+ *  shapeLib's sweepRegion.  Fast circles cannot pass through thin rects.
+ */
+int circleRectSweep(const AbCircle *circle, const Vec2 *circlePos, const Vec2 *velocity,
+		    const AbRect *rect, const Vec2 *rectPos, Sweep *hit);
+
 #endif
 
 
@@ -4,12 +4,21 @@
 // true if pixel is in circle centered at centerPos
 int abCircleCheck(const AbCircle *circle, const Vec2 *centerPos, const Vec2 *pixel)
 {
-  u_char radius = circle->radius;
-  int axis;
+  int near, far;
   Vec2 relPos;
   vec2Sub(&relPos, pixel, centerPos); /* vector from center to pixel */
   vec2Abs(&relPos);		      /* project to first quadrant */
-  return (relPos.axes[0] <= radius && circle->chords[relPos.axes[0]] >= relPos.axes[1]);
+  near = relPos.axes[0]; far = relPos.axes[1];
+  if (near > far) {		/* fold into first octant */
+    near = far; far = relPos.axes[0];
+  }
+  return near <= circle->octant && far <= circle->chords[near];
+}
+
+u_char
+abCircleChord(const AbCircle *circle, u_char dist)
+{
+  return circle->chords[dist];
 }
   
 void
@@ -23,3 +32,16 @@ abCircleGetBounds(const AbCircle *circle, const Vec2 *centerPos, Region *bounds)
   regionClipScreen(bounds);
 }
 
+// a circle's row is a single span (chords are symmetric across the diagonal)
+void
+abCircleRowSpans(const AbCircle *circle, const Vec2 *centerPos, int row, SpanFn emit, void *ctx)
+{
+  int halfWidth;
+  row -= centerPos->axes[1];
+  if (row < 0)
+    row = -row;
+  if (row > circle->radius)
+    return;
+  halfWidth = abCircleChord(circle, row);
+  (*emit)(ctx, centerPos->axes[0] - halfWidth, centerPos->axes[0] + halfWidth);
+}
@@ -0,0 +1,78 @@
+/** \file circlebench.c
+ *  \brief Compares ways of drawing the same circle.
+ *
+ *  Times (in stopwatch ticks) REPS renderings of circle14 by:
+ *  layerDraw of a single circle layer (whole screen), layerDrawRegion
+ *  of the circle's bounds (per-pixel checks), fillCircle (one span per
+ *  row) and fillRing.
+ */
+#include <msp430.h>
+#include <libTimer.h>
+#include <lcdutils.h>
+#include <lcddraw.h>
+#include <lcdnum.h>
+#include "abCircle.h"
+
+#define REPORT_COL 70		/**< of the results' values */
+
+#define REPS 4
+#define CENTER_COL (screenWidth/2)
+#define CENTER_ROW (screenHeight/2)
+
+u_int bgColor = COLOR_BLUE;
+
+Layer circleLayer = {		/**< the circle, alone */
+  (AbShape *)&circle14,
+  {CENTER_COL, CENTER_ROW},
+  {0,0}, {0,0},				    /* last & next pos */
+  COLOR_ORANGE,
+  0
+};
+
+void main()
+{
+  Region bounds;
+  u_char rep;
+  unsigned long whole, region, fill, ring;
+
+  configureClocks();
+  lcd_init();
+  or_sr(0x8);			/**< GIE: stopwatch overflow */
+
+  layerInit(&circleLayer);
+  layerGetBounds(&circleLayer, &bounds);
+
+  stopwatchStart();
+  for (rep = 0; rep < REPS; rep++)
+    layerDraw(&circleLayer);
+  stopwatchStop();
+  whole = stopwatchRead();
+
+  stopwatchStart();
+  for (rep = 0; rep < REPS; rep++)
+    layerDrawRegion(&circleLayer, &bounds);
+  stopwatchStop();
+  region = stopwatchRead();
+
+  stopwatchStart();
+  for (rep = 0; rep < REPS; rep++)
+    fillCircle(CENTER_COL, CENTER_ROW, &circle14, COLOR_RED);
+  stopwatchStop();
+  fill = stopwatchRead();
+
+  stopwatchStart();
+  for (rep = 0; rep < REPS; rep++)
+    fillRing(CENTER_COL, CENTER_ROW, &circle5, &circle14, COLOR_GREEN);
+  stopwatchStop();
+  ring = stopwatchRead();
+
+  clearScreen(COLOR_BLACK);
+  drawReportLine(0, "layerDraw", whole, REPORT_COL);
+  drawReportLine(1, "region", region, REPORT_COL);
+  drawReportLine(2, "fillCircle", fill, REPORT_COL);
+  drawReportLine(3, "fillRing", ring, REPORT_COL);
+  fillRing(CENTER_COL, CENTER_ROW + 30, &circle5, &circle14, COLOR_GREEN);
+
+  for (;;)
+    or_sr(0x10);		/**< CPU OFF */
+}
@@ -0,0 +1,56 @@
+#include <lcdutils.h>
+#include <lcddraw.h>
+#include "shape.h"
+#include "_abCircle.h"
+
+/* fill cols colMin..colMax (inclusive) of row, clipped to the screen */
+static void
+fillSpan(int colMin, int colMax, int row, u_int colorBGR)
+{
+  if (row < 0 || row > screenHeight - 1)
+    return;
+  if (colMin < 0)
+    colMin = 0;
+  if (colMax > screenWidth - 1)
+    colMax = screenWidth - 1;
+  if (colMin <= colMax)
+    fillRectangle(colMin, row, colMax - colMin + 1, 1, colorBGR);
+}
+
+/* fill the rows at dist above & below row with the same spans */
+static void
+fillMirrored(int colMin, int colMax, int row, u_char dist, u_int colorBGR)
+{
+  fillSpan(colMin, colMax, row - dist, colorBGR);
+  if (dist)
+    fillSpan(colMin, colMax, row + dist, colorBGR);
+}
+
+void
+fillCircle(int col, int row, const AbCircle *circle, u_int colorBGR)
+{
+  u_char dist;
+  for (dist = 0; dist <= circle->radius; dist++) {
+    int halfWidth = abCircleChord(circle, dist);
+    fillMirrored(col - halfWidth, col + halfWidth, row, dist, colorBGR);
+  }
+}
+
+void
+fillRing(int col, int row, const AbCircle *inner, const AbCircle *outer, 
+	 u_int colorBGR)
+{
+  u_char dist;
+  for (dist = 0; dist <= outer->radius; dist++) {
+    int outerHalf = abCircleChord(outer, dist);
+    if (dist > inner->radius) {	/* above or below the hole */
+      fillMirrored(col - outerHalf, col + outerHalf, row, dist, colorBGR);
+    } else {			/* either side of the hole */
+      int innerHalf = abCircleChord(inner, dist);
+      if (innerHalf < outerHalf) {
+	fillMirrored(col - outerHalf, col - innerHalf - 1, row, dist, colorBGR);
+	fillMirrored(col + innerHalf + 1, col + outerHalf, row, dist, colorBGR);
+      }
+    }
+  }
+}
@@ -0,0 +1,184 @@
+#include "shape.h"
+#include "_abCircle.h"
+
+/* true if (near, far) (both >= 0) is within circle's chords */
+static int
+withinChords(const AbCircle *circle, int near, int far)
+{
+  if (near > far) {		/* fold into first octant */
+    int t = near; near = far; far = t;
+  }
+  return near <= circle->octant && far <= circle->chords[near];
+}
+
+static int
+iabs(int v)
+{
+  return v < 0 ? -v : v;
+}
+
+static int
+sign(int v)
+{
+  return (v > 0) - (v < 0);
+}
+
+int
+circleRectCollide(const AbCircle *circle, const Vec2 *circlePos, 
+		  const AbRect *rect, const Vec2 *rectPos, Contact *contact)
+{
+  int lo[2], hi[2], nearest[2];	/* relative to circle's center */
+  int radius = circle->radius;
+  u_char axis;
+  for (axis = 0; axis < 2; axis++) {
+    int rel = rectPos->axes[axis] - circlePos->axes[axis];
+    lo[axis] = rel - rect->halfSize.axes[axis];
+    hi[axis] = rel + rect->halfSize.axes[axis];
+    if (lo[axis] > radius || hi[axis] < -radius)
+      return 0;			/* bounding boxes disjoint */
+    nearest[axis] = lo[axis] > 0 ? lo[axis] : (hi[axis] < 0 ? hi[axis] : 0);
+  }
+  /* the rect's pixel nearest the center is the nearest on both axes */
+  if (!withinChords(circle, iabs(nearest[0]), iabs(nearest[1])))
+    return 0;
+
+  if (!nearest[0] && !nearest[1]) { /* center within rect: shortest exit */
+    contact->depth = 0x7fff;
+    for (axis = 0; axis < 2; axis++) {
+      int up = radius - lo[axis] + 1, down = hi[axis] + radius + 1;
+      if (up < contact->depth) {
+	contact->depth = up;
+	contact->normal = vec2Zero; contact->normal.axes[axis] = -1;
+      }
+      if (down < contact->depth) {
+	contact->depth = down;
+	contact->normal = vec2Zero; contact->normal.axes[axis] = 1;
+      }
+    }
+  } else {			/* push away from nearest pixel */
+    int overlap[2];		/* how far the circle reaches past it */
+    for (axis = 0; axis < 2; axis++)
+      overlap[axis] = nearest[axis] ? 
+	abCircleChord(circle, iabs(nearest[1-axis])) - iabs(nearest[axis]) + 1 : 0x7fff;
+    contact->normal = vec2Zero;
+    contact->depth = overlap[0] < overlap[1] ? overlap[0] : overlap[1];
+    for (axis = 0; axis < 2; axis++)
+      if (overlap[axis] == contact->depth) /* both at a corner's diagonal */
+	contact->normal.axes[axis] = -sign(nearest[axis]);
+  }
+  return 1;
+}
+
+int
+circleCircleCollide(const AbCircle *a, const Vec2 *aPos, 
+		    const AbCircle *b, const Vec2 *bPos, Contact *contact)
+{
+  int dCol = aPos->axes[0] - bPos->axes[0], dRow = aPos->axes[1] - bPos->axes[1];
+  int reach = a->radius + b->radius;
+  int absCol = iabs(dCol), absRow = iabs(dRow), near, far;
+  int row, rowMin, rowMax, hit = 0;
+  if (absCol > reach || absRow > reach)
+    return 0;			/* bounding boxes disjoint */
+
+  rowMin = aPos->axes[1] - a->radius; /* rows both cover */
+  if (bPos->axes[1] - b->radius > rowMin)
+    rowMin = bPos->axes[1] - b->radius;
+  rowMax = aPos->axes[1] + a->radius;
+  if (bPos->axes[1] + b->radius < rowMax)
+    rowMax = bPos->axes[1] + b->radius;
+  for (row = rowMin; row <= rowMax && !hit; row++) /* do spans overlap? */
+    hit = absCol <= abCircleChord(a, iabs(row - aPos->axes[1])) 
+      + abCircleChord(b, iabs(row - bPos->axes[1]));
+  if (!hit)
+    return 0;
+
+  contact->normal = vec2Zero;	/* nearest of 8 directions from b to a */
+  if (absRow <= (absCol << 1))	/* not within ~22.5 degrees of vertical */
+    contact->normal.axes[0] = sign(dCol);
+  if (absCol <= (absRow << 1))	/* not within ~22.5 degrees of horizontal */
+    contact->normal.axes[1] = sign(dRow);
+  if (!absCol && !absRow)
+    contact->normal.axes[1] = -1; /* concentric: push up */
+  near = absCol < absRow ? absCol : absRow;
+  far = absCol + absRow - near;
+  /* distance between centers ~ far + 3/8 near (exact on axes) */
+  contact->depth = reach + 1 - (far + ((near + (near << 1)) >> 3));
+  if (contact->depth < 1)
+    contact->depth = 1;
+  return 1;
+}
+
+int
+circleFenceCollide(const AbCircle *circle, const Vec2 *circlePos, 
+		   const Region *fence, Contact *contact)
+{
+  int radius = circle->radius;
+  u_char axis;
+  contact->normal = vec2Zero;
+  contact->depth = 0;
+  for (axis = 0; axis < 2; axis++) {
+    int past = fence->topLeft.axes[axis] - (circlePos->axes[axis] - radius);
+    int normal = 1;		/* beyond top or left: push down or right */
+    if (past <= 0) {
+      past = circlePos->axes[axis] + radius - fence->botRight.axes[axis];
+      normal = -1;
+    }
+    if (past > 0) {
+      contact->normal.axes[axis] = normal;
+      if (past > contact->depth)
+	contact->depth = past;
+    }
+  }
+  return contact->depth > 0;
+}
+
+int
+circleRectSweep(const AbCircle *circle, const Vec2 *circlePos, const Vec2 *velocity,
+		const AbRect *rect, const Vec2 *rectPos, Sweep *hit)
+{
+  Region bounds, rectBounds;
+  u_int time, step, entry;
+  int radius = circle->radius, speed;
+  u_char axis;
+  for (axis = 0; axis < 2; axis++) { /* (unclipped) bounding box */
+    bounds.topLeft.axes[axis] = circlePos->axes[axis] - radius;
+    bounds.botRight.axes[axis] = circlePos->axes[axis] + radius;
+  }
+  abRectGetBounds(rect, rectPos, &rectBounds);
+  if (!(bounds.botRight.axes[0] < rectBounds.topLeft.axes[0] ||
+	bounds.topLeft.axes[0] > rectBounds.botRight.axes[0] ||
+	bounds.botRight.axes[1] < rectBounds.topLeft.axes[1] ||
+	bounds.topLeft.axes[1] > rectBounds.botRight.axes[1])) {
+    Contact contact;
+    if (circleRectCollide(circle, circlePos, rect, rectPos, &contact))
+      return 0;			/* touching already: not reported */
+    hit->time = 0;		/* boxes overlap already, circle does not */
+    hit->normal = vec2Zero;
+  } else if (!sweepRegion(&bounds, velocity, &rectBounds, hit)) {
+    return 0;
+  }
+
+  /* boxes touch first at entry; step until the circle itself does 
+     (later only if it meets a corner).  Steps are short enough that
+     neither axis moves more than a pixel per step */
+  speed = iabs(velocity->axes[0]) + iabs(velocity->axes[1]);
+  if (!speed)
+    return 0;
+  step = sweepFrac(1, speed);
+  entry = hit->time;
+  for (time = entry; ; time += step) {
+    Vec2 pos = *circlePos;
+    Contact contact;
+    if (time > SWEEP_ONE)	/* always try the end of the step */
+      time = SWEEP_ONE;
+    sweepMove(&pos, velocity, time);
+    if (circleRectCollide(circle, &pos, rect, rectPos, &contact)) {
+      hit->time = time;
+      if (time != entry || !(hit->normal.axes[0] | hit->normal.axes[1]))
+	hit->normal = contact.normal;
+      return 1;
+    }
+    if (time == SWEEP_ONE)
+      return 0;
+  }
+}
@@ -15,14 +15,13 @@ void computeChordVec(unsigned char chordVec[], unsigned char radius)
   int dRowSquared = 1;	    // change in row**2 for a unit increase in row
 
   int radiusSqErr = 0;		/* (radius, 0) is on the circle  */
-  int colPrev = 0;		/* initially bogus value  to force first entry*/
   while (col >= row) {		/* only sweep first octant */
     chordVec[row] = col;      /* row always changes in first octant */
 
     /* mirror into 2nd octant */
-    if (colPrev != col)		/* col sometimes repeats in first octant */
-      chordVec[col] = row;	/* only save first (max) col for row */
-    colPrev = col;
+    chordVec[col] = row;	/* col sometimes repeats in first octant: */
+				/* the last (max) row is kept, so that */
+				/* chordVec is the same along both axes */
 
     row++;			/* move vertically (slope <= -1 for first octant) */
     radiusSqErr += dRowSquared;	/* current radiusSqErr */
@@ -39,12 +38,23 @@ void computeChordVec(unsigned char chordVec[], unsigned char radius)
 #include "assert.h"
 
 
+/* Last entry of chordVec's first octant: chordVec[d] for d <= octant 
+   holds everything, since (by symmetry) (col, row) is within the circle 
+   iff min(col,row) <= octant && max(col,row) <= chordVec[min(col,row)] */
+int chordOctant(unsigned char chordVec[], unsigned char radius)
+{
+  int octant = 0;
+  while (octant < radius && chordVec[octant + 1] >= octant + 1)
+    octant++;
+  return octant;
+}
+
 // Generate circles as source files
 // (c) Eric Freudenthal, 2016
 int main()
 {
-  int radius;
-  char chordVec[151];
+  int radius, totalBytes = 0;
+  unsigned char chordVec[151];
   FILE *circleIncludeFile = fopen("abCircle_decls.h", "w");
   FILE *chordIncludeFile = fopen("chordVec.h", "w");
   assert(chordIncludeFile); assert(circleIncludeFile);
@@ -55,13 +65,16 @@ int main()
   fprintf(chordIncludeFile, "// Automatically generated by makeCircles.  (c) Eric Freudenthal, 2016\n");
   fprintf(chordIncludeFile, "#ifndef chordVec_included\n#define chordVec_included\n\n");
 
+  printf("radius  octant  map  bytes (chord entries)\n");
   for (radius = 2; radius <= 150; radius++) {
     char filename[100];
     unsigned char chordIndex;
+    int octant;
     
     computeChordVec(chordVec, radius);
+    octant = chordOctant(chordVec, radius);
 
-    {				/* chordVecN.c */
+    {				/* chordVecN.c: first octant, then the second's map */
       sprintf(filename, "circles/chordVec%d.c", radius);
       FILE *fp = fopen(filename, "w");
       assert(fp);
@@ -69,7 +82,8 @@ int main()
       fprintf(fp, "#include \"chordVec.h\"\n\n");
       fprintf(fp, "const unsigned char chordVec%d[%d] = {\n", radius, radius+1);
       for (chordIndex = 0; chordIndex <= radius; chordIndex ++) 
-	fprintf(fp, "    %d, // dist along axis = %d\n", chordVec[chordIndex], chordIndex);
+	fprintf(fp, "    %d, // dist along axis = %d%s\n", chordVec[chordIndex], chordIndex,
+		chordIndex == octant + 1 ? " (second octant: col to row)" : "");
       fprintf(fp, "};\n\n");
       fclose(fp);
     } {				/* abCircleN.c */
@@ -80,24 +94,22 @@ int main()
       fprintf(fp, "#include \"abCircle.h\"\n\n");
       fprintf(fp, "#include \"chordVec.h\"\n\n");
       fprintf(fp, "const AbCircle circle%d = {" , radius);
-      fprintf(fp, "  abCircleGetBounds, abCircleCheck, chordVec%d, %d", radius, radius);
+      fprintf(fp, "  abCircleGetBounds, abCircleCheck, abCircleRowSpans, chordVec%d, %d, %d", 
+	      radius, radius, octant);
       fprintf(fp, "};\n");
       fclose(fp);
     }
     				/* includes */
     fprintf(chordIncludeFile, "extern const unsigned char chordVec%d[%d];\n", radius, radius+1);
     fprintf(circleIncludeFile, "extern const AbCircle circle%d;\n" , radius);
+
+    printf("%6d %7d %4d %6d\n", radius, octant + 1, radius - octant, radius + 1);
+    totalBytes += radius + 1;
   }
+  printf(" total %18d\n", totalBytes);
 
   fprintf(circleIncludeFile, "\n#endif // included \n");
   fprintf(chordIncludeFile, "\n#endif // included \n");
   fclose(chordIncludeFile);
   fclose(circleIncludeFile);
 }
-
-
-
-    
-    
-    
-
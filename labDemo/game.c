@@ -2,30 +2,43 @@
 #include <libTimer.h>
 #include <lcdutils.h>    /*used for shhape creation */
 #include <lcddraw.h>
+#include <lcdnum.h>
+#include <lcdpower.h>
 #include <shape.h>
 #include <abCircle.h>
 #include <p2switches.h>  /*used for switch manipulation */
 #include "buzzer.h"      /* for buzzer */
+#include "splash.h"      /* welcome image, generated by makeImage */
 
 #define GREEN_LED BIT6   /*sets bit for leds */
 #define RED_LED BIT0
 #define MIN_PERIOD 1000  /*buzzer advance parameters */
 #define MAX_PERIOD 10000
+#define WIN_POINTS 3     /* goals to win */
+#define PAINT_ROWS 16    /* of the first screen painted per frame */
+#define PADDLE_HALF 12   /* paddle half height */
+#define BALL_RADIUS 5    /* circle5 */
+#define PADDLE_REACH (PADDLE_HALF + BALL_RADIUS) /* farthest hit from a paddle's center */
+#define BALL_SPEED FIX(6)               /* pixels per step, off a paddle */
+#define MAX_DEFLECT ANGLE_DEG(60)       /* off a paddle's end */
+#define STEP_TICKS 15    /* watchdog interrupts per simulation step */
+#define DIM_STEPS (5 * 250 / STEP_TICKS) /* game over screen dims after 5s without input */
+#define OVER_ROW (screenHeight/2)        /* of "Game Over!" (kept in partial mode) */
 u_int leftPoints = 0;   /* point counters */
 u_int rightPoints = 0;   
 static unsigned int period = 1000;  /*/*buzzer advance parameters */
 static signed int rate = 500;	
 
 //Instantiates shapes
-AbRect rect10 = {abRectGetBounds, abRectCheck, {3,3}};
-AbRect playerPaddle = {abRectGetBounds, abRectCheck, {2,12}};
-AbRect enemyPaddle = {abRectGetBounds, abRectCheck, {2,12}};
-AbRect yourScoreArea = {abRectGetBounds, abRectCheck, {1,screenWidth-10}};
-AbRect enemyScoreArea = {abRectGetBounds, abRectCheck, {1,screenWidth-10}};
+AbRect rect10 = {abRectGetBounds, abRectCheck, abRectRowSpans, {3,3}};
+AbRect playerPaddle = {abRectGetBounds, abRectCheck, abRectRowSpans, {2,PADDLE_HALF}};
+AbRect enemyPaddle = {abRectGetBounds, abRectCheck, abRectRowSpans, {2,PADDLE_HALF}};
+AbRect yourScoreArea = {abRectGetBounds, abRectCheck, abRectRowSpans, {1,screenWidth-10}};
+AbRect enemyScoreArea = {abRectGetBounds, abRectCheck, abRectRowSpans, {1,screenWidth-10}};
 
 //Self explanatory, the edges of the playing field
 AbRectOutline fieldOutline = { 
-  abRectOutlineGetBounds, abRectOutlineCheck,   
+  abRectOutlineGetBounds, abRectOutlineCheck, abRectOutlineRowSpans,
   {screenWidth/2 - 5, screenHeight/2 - 10}
 };
 
@@ -74,29 +87,54 @@ Layer fieldLayer = {
   &playerPaddleLayer,
 };
 
+//Score text, one digit per player
+char leftScoreText[] = "0", rightScoreText[] = "0";
+AbText leftScore = {abTextGetBounds, abTextCheck, abTextRowSpans, leftScoreText, 1, FONT_SM};
+AbText rightScore = {abTextGetBounds, abTextCheck, abTextRowSpans, rightScoreText, 1, FONT_SM};
+
+/*right player's score, drawn behind the ball */
+Layer rightScoreLayer = {
+  (AbShape *)&rightScore,
+  {(screenWidth*3/4)+2, 4},	/**< center, glyph's top left at (96,0) */
+  {0,0}, {0,0},				    /* last & next pos */
+  COLOR_RED,
+  &fieldLayer,
+};
+
+/*left player's score */
+Layer leftScoreLayer = {
+  (AbShape *)&leftScore,
+  {32, 4},			/**< center, glyph's top left at (30,0) */
+  {0,0}, {0,0},				    /* last & next pos */
+  COLOR_BLUE,
+  &rightScoreLayer,
+};
+
 //Ball layer
 Layer ballLayer = {
   (AbShape *)&circle5,
   {(screenWidth/2)+10, (screenHeight/2)+5}, /**< bit below & right of center */
   {0,0}, {0,0},				    /* last & next pos */
   COLOR_ORANGE,
-  &fieldLayer,
+  &leftScoreLayer,
 };
 
-/** Moving Layer
- *  Linked list of layer references
- *  Velocity represents one iteration of change (direction & magnitude)
- */
-typedef struct MovLayer_s {
-  Layer *layer;
-  Vec2 velocity;
-  struct MovLayer_s *next;
-} MovLayer;
-
 /*All layers that move contained in a linked list, {col,row} velocity */
 MovLayer ml3 = { &playerPaddleLayer, {0,0}, 0 }; 
 MovLayer ml1 = { &enemyPaddleLayer, {0,0}, &ml3 };
-MovLayer ml0 = { &ballLayer, {1,2}, &ml1}; 
+MovLayer ml0 = { &ballLayer, {3*MOV_ONE, 5*MOV_ONE}, &ml1}; 
+
+/*collision groups */
+#define BALL 1
+#define PADDLE 2
+#define ZONE 4
+
+/*the ball bounces off the fence, paddles and score zones; paddles stop at the fence */
+Collider ballCollider = { &ballLayer, &ml0, BALL, COLLIDE_FENCE | PADDLE | ZONE, COLLIDE_BOUNCE };
+Collider playerCollider = { &playerPaddleLayer, &ml3, PADDLE, COLLIDE_FENCE, COLLIDE_STOP };
+Collider enemyCollider = { &enemyPaddleLayer, &ml1, PADDLE, COLLIDE_FENCE, COLLIDE_STOP };
+Collider yourZoneCollider = { &yourScoreZone, 0, ZONE, 0, COLLIDE_TRIGGER };
+Collider enemyZoneCollider = { &enemyScoreZone, 0, ZONE, 0, COLLIDE_TRIGGER };
 
 
 /*initializes buzzer bits */
@@ -129,178 +167,117 @@ void buzzerAdvance()
   buzzer_set_period(period);
 }
 
-/*advances through the moving layers */
-void movLayerDraw(MovLayer *movLayers, Layer *layers)
+/*paddle velocities from the switches: S1/S2 move yours, S3/S4 the red one */
+void paddleControls(u_int switches)
 {
-  int row, col;
-  MovLayer *movLayer;
-
-  and_sr(~8);			/**< disable interrupts (GIE off) */
-  for (movLayer = movLayers; movLayer; movLayer = movLayer->next) { /* for each moving layer */
-    Layer *l = movLayer->layer;
-    l->posLast = l->pos;
-    l->pos = l->posNext;
-  }
-  or_sr(8);			/**< disable interrupts (GIE on) */
-
-  /*for each moving layer */
-  for (movLayer = movLayers; movLayer; movLayer = movLayer->next) {
-    Region bounds;
-    layerGetBounds(movLayer->layer, &bounds);
-    lcd_setArea(bounds.topLeft.axes[0], bounds.topLeft.axes[1], 
-		bounds.botRight.axes[0], bounds.botRight.axes[1]);
-    for (row = bounds.topLeft.axes[1]; row <= bounds.botRight.axes[1]; row++) {
-      for (col = bounds.topLeft.axes[0]; col <= bounds.botRight.axes[0]; col++) {
-	Vec2 pixelPos = {col, row};
-	u_int color = bgColor;
-	Layer *probeLayer;
-	for (probeLayer = layers; probeLayer; 
-	     probeLayer = probeLayer->next) { /* probe all layers, in order */
-	  if (abShapeCheck(probeLayer->abShape, &probeLayer->pos, &pixelPos)) {
-	    color = probeLayer->color;
-	    break; 
-	  } /* if probe check */
-	} // for checking all layers at col, row
-	lcd_writeColor(color); 
-      } // for col
-    } // for row
-  } // for moving layer being updated
-}	  
-
-/*method for detecting collision with other objects */
-void mlAdvance(MovLayer *ml, Region *fence, Region *paddle, Region *enemy,
-	       Region *enemyGotScore, Region *youGotScore)
+  if (!(switches & (1<<0)))
+    ml3.velocity.axes[1] = -3*MOV_ONE;
+  else if (!(switches & (1<<1)))
+    ml3.velocity.axes[1] = 3*MOV_ONE;
+  else
+    ml3.velocity.axes[1] = 0;
+
+  if (!(switches & (1<<2)))
+    ml1.velocity.axes[1] = -3*MOV_ONE;
+  else if (!(switches & (1<<3)))
+    ml1.velocity.axes[1] = 3*MOV_ONE;
+  else
+    ml1.velocity.axes[1] = 0;
+}
+
+/*sends the ball back off a paddle's face at an angle set by where it hit:
+  straight back at the paddle's center, up to MAX_DEFLECT at its ends */
+void paddleDeflect(const Layer *paddle, const Vec2 *normal)
 {
-  Vec2 newPos;
-  u_char axis;
-  Region shapeBoundary; /*the ever changing mov boundary */
-  u_int switchDisplay = p2sw_read(), i; /*used for switch detection */
-  int switchPress = switchDisplay & (1<<i);
-  //ml->velocity.axes[1] = 0;
-  for (; ml; ml = ml->next) {
-    vec2Add(&newPos, &ml->layer->posNext, &ml->velocity);
-    abShapeGetBounds(ml->layer->abShape, &newPos, &shapeBoundary);
-
-    //Controls for your paddle
-    if(!(switchDisplay & (1<<0)) && !(ml->next) ){
-     ml->velocity.axes[1] = -3;
-    }
-     else if(!(switchDisplay & (1<<1)) && !(ml->next) ){
-     ml->velocity.axes[1] = 3;
-    }
-    //Controls for red paddle
-    else if( !(switchDisplay & (1<<2)) && (ml->next) && !(ml->next->next) ){
-     ml->velocity.axes[1] = -3;
-    } 
-    else if( !(switchDisplay & (1<<3)) && (ml->next) && !(ml->next->next) ){
-     ml->velocity.axes[1] = 3;
-    }
-    else if (ml->next && ml->next->next){}
-    else{
-       ml->velocity.axes[1] = 0;
-       }   
-
-    
-    for (axis = 0; axis < 2; axis ++) {
-      //Fence Collision Detection
-      if ((shapeBoundary.topLeft.axes[axis] < fence->topLeft.axes[axis]) ||
-	  (shapeBoundary.botRight.axes[axis] > fence->botRight.axes[axis]) ) {
-	int velocity = ml->velocity.axes[axis] = -ml->velocity.axes[axis];
-	newPos.axes[axis] += (2*velocity);
-	buzzer_set_period(2000);
-	}	/**< if outside of fence */
-
-      //Your paddle collision detection 
-      if(ml->next){
-       if ((shapeBoundary.topLeft.axes[0] < paddle->botRight.axes[0]) &&
-	   (shapeBoundary.topLeft.axes[1] < paddle->botRight.axes[1]) &&   
-	   (shapeBoundary.topLeft.axes[1] > paddle->topLeft.axes[1]))
-       {  
-        int velocity = ml->velocity.axes[axis] = -ml->velocity.axes[axis];
-        newPos.axes[axis] += (2*velocity);
-        buzzer_set_period(7500);
-       }	/**< if inside of paddle */
-      } /**<if the mov layer is NOT your paddle */
-      
-      //Enemy Paddle collision detection (SET EACH AXES VELOCITY
-      if(ml->next->next){
-	//Once object passes closest x coor withing the given y coor
-	if ((shapeBoundary.botRight.axes[0] > enemy->topLeft.axes[0]) &&  
-	    (shapeBoundary.botRight.axes[1] < enemy->botRight.axes[1]) && 
-	    (shapeBoundary.botRight.axes[1] > enemy->topLeft.axes[1]))
-	 {
-	   //x needs to reverse
-	  int velocity = ml->velocity.axes[axis] = -ml->velocity.axes[axis];
-	  newPos.axes[axis] += (2*velocity);
-	  buzzer_set_period(1500);   
-	 } 	/**< if inside of enemy */
-      } /**<if layer is ball */
-      
-      //Your score zone collision detection
-      if (shapeBoundary.topLeft.axes[0] < youGotScore->botRight.axes[0]){ 
-	int velocity = ml->velocity.axes[axis] = -ml->velocity.axes[axis];
-        newPos.axes[axis] += (2*velocity);
-	rightPoints++;
-	char str = rightPoints<<2;
-	//drawChar5x7(60,0, str, COLOR_RED, COLOR_WHITE);
-	if (rightPoints == 0){
-	drawChar5x7(screenWidth*.75,0, '0', COLOR_RED, COLOR_WHITE);
-	}
-	else if (rightPoints == 2){
-	  drawChar5x7(screenWidth*.75,0, '1', COLOR_RED, COLOR_WHITE);
-	}
-	else if (rightPoints == 4){
-	  drawChar5x7(screenWidth*.75,0, '2', COLOR_RED, COLOR_WHITE);
-	  }
-	else if (rightPoints == 6){
-	  drawChar5x7(screenWidth*.75,0, '3', COLOR_RED, COLOR_WHITE);
-	  }
-	/*else{drawChar5x7(60,0, '9', COLOR_RED, COLOR_WHITE);}
-	buzzerAdvance(); */
-      }	/**< if inside your scoring */
-
-      //Enemy score zone collision detection
-      if (shapeBoundary.botRight.axes[0] > enemyGotScore->topLeft.axes[0]){
-	int velocity = ml->velocity.axes[axis] = -ml->velocity.axes[axis];
-	newPos.axes[axis] += (2*velocity);
-	if (leftPoints<6){
-	buzzerAdvance();
-	}
-	leftPoints++;
-	
-	if (leftPoints == 0){
-	drawChar5x7(30,0, '0', COLOR_BLUE, COLOR_WHITE);
-	}
-	else if (leftPoints == 2){
-	  drawChar5x7(30,0, '1', COLOR_BLUE, COLOR_WHITE);
-	}
-	else if (leftPoints == 4){
-	  drawChar5x7(30,0, '2', COLOR_BLUE, COLOR_WHITE);
-	  }
-	else if (leftPoints == 6){
-	  drawChar5x7(30,0, '3', COLOR_BLUE, COLOR_WHITE);
-	  }
-      }	/**< if inside of Enemy Scoring */
-      
-    } /**< for axis */
-    // buzzer_set_period(0);  /*resets buzzer period */
-    ml->layer->posNext = newPos;
-    
-  } /**< for ml */ 
+  int offset = ballLayer.posNext.axes[1] - paddle->posNext.axes[1];
+  Angle deflect;
+  if (!normal->axes[0])		/* off the paddle's top or bottom: */
+    return;			/* just bounced */
+  if (offset > PADDLE_REACH)
+    offset = PADDLE_REACH;
+  else if (offset < -PADDLE_REACH)
+    offset = -PADDLE_REACH;
+  deflect = fixScale(offset, FIX_RATIO(MAX_DEFLECT, PADDLE_REACH));
+  if (normal->axes[0] < 0)	/* back toward the left */
+    deflect = ANGLE_TURN/2 - deflect;
+  vec2Direction(&ml0.velocity, deflect, BALL_SPEED);
 }
 
+/*sounds and scores for whatever the ball hits */
+void ballHit(Collider *self, Collider *other, const Vec2 *normal)
+{
+  if (self != &ballCollider)
+    return;
+  if (!other)			/* the fence */
+    buzzer_set_period(2000);
+  else if (other == &playerCollider) {
+    buzzer_set_period(7500);
+    paddleDeflect(&playerPaddleLayer, normal);
+  } else if (other == &enemyCollider) {
+    buzzer_set_period(1500);   
+    paddleDeflect(&enemyPaddleLayer, normal);
+  }
+  else if (other == &yourZoneCollider)
+    rightPoints++;		/**< score redrawn by main loop */
+  else if (other == &enemyZoneCollider) {
+    if (leftPoints < WIN_POINTS){
+      buzzerAdvance();
+    }
+    leftPoints++;		/**< score redrawn by main loop */
+  }
+}
 
 u_int bgColor = COLOR_WHITE;    /**< The background color */
-int redrawScreen = 1;           /**< Boolean for whether screen needs to be redrawn */
 
 Region fieldFence;		/**< fence around playing field  */
-Region ePaddle;                 /**< Enemy Paddle*/
-Region urPaddle;                /**< Your paddle */
-Region score;                   /**< lefthand scoring region */
-Region enemyScore;              /**< Righthand scoring region */
+CollisionWorld world = { 0, &fieldFence, ballHit };
+
+/*one simulation step: paddles follow the switches, then everything moves */
+void gameStep()
+{
+  P1OUT |= GREEN_LED;           /**< Green led on when CPU on */
+  paddleControls(p2sw_read());
+  collisionStep(&world);
+}
+
+/*draws where the last step left things */
+void gameRender()
+{
+  layerDrawStep(PAINT_ROWS);    /**< the first screen, a band per frame */
+  movLayerDraw(&ml0, &ballLayer);
+  /* repaints a score's glyph only when its digit changes */
+  layerTextSetNumber(&leftScoreLayer, &ballLayer, leftPoints, NUM_DEC);
+  layerTextSetNumber(&rightScoreLayer, &ballLayer, rightPoints, NUM_DEC);
+  buzzer_set_period(0);   
+  P1OUT &= ~GREEN_LED;          /**< Green led off witHo CPU */
+}
+
+char started = 0;               /**< a switch was pressed on the welcome screen */
+
+/*welcome: waits for any switch */
+void welcomeStep()
+{
+  P1OUT |= GREEN_LED;           /**< Green led on when CPU on */
+  if (~p2sw_read() & 15)
+    started = 1;
+}
+
+/*game over: dims the display until a switch is touched */
+void gameOverStep()
+{
+  u_int switches = p2sw_read();
+  P1OUT |= GREEN_LED;           /**< Green led on when CPU on */
+  lcd_powerStep((switches >> 8) || (~switches & 15)); /* changed or held */
+}
+
+/*nothing moves on the welcome and game over screens */
+void stillRender()
+{
+  P1OUT &= ~GREEN_LED;          /**< Green led off witHo CPU */
+}
 
 /*States for the switch statement */
-typedef enum {welcomeMenu,play,scored} states;
+typedef enum {welcomeMenu,play,scored,over} states;
 
 /** Initializes everything, enables interrupts and green LED, 
  *  and handles the rendering for the screen
@@ -311,45 +288,43 @@ void main()
   P1OUT |= GREEN_LED;
 
   configureClocks();            /**< initializes needed librarys/methods */
-  lcd_init();
+  lcd_initBegin();              /**< finished by lcd_initTick while we prepare */
+  frameLoopInit(STEP_TICKS);  /**< a step every 15 interrupts */
+  enableWDTInterrupts();      /**< enable periodic interrupt */
+  or_sr(0x8);	              /**< GIE (enable interrupts) */
   shapeInit();
   p2sw_init(15);
   shapeInit();
   buzzerInit();
 
   layerInit(&ballLayer);        /**< inilitalize layers*/
-  layerDraw(&ballLayer);
   
   layerGetBounds(&fieldLayer, &fieldFence); /**<Initialize moving layers*/
-  layerGetBounds(&enemyScoreZone, &score);
-  layerGetBounds(&yourScoreZone, &enemyScore);
+  colliderAdd(&world, &ballCollider);
+  colliderAdd(&world, &playerCollider);
+  colliderAdd(&world, &enemyCollider);
+  colliderAdd(&world, &yourZoneCollider);
+  colliderAdd(&world, &enemyZoneCollider);
   
-
-  enableWDTInterrupts();      /**< enable periodic interrupt */
-  or_sr(0x8);	              /**< GIE (enable interrupts) */
+  while (!lcd_ready)            /**< woken by each (pending) step */
+    or_sr(0x10);
+  frameLoopInit(STEP_TICKS);    /**< drop the steps due while booting */
+  layerDrawBegin(&ballLayer);   /**< painted by gameRender while play starts */
 
   /*sets starting state, and continues to run state machine until 'end' is reached*/
   states state = welcomeMenu;
-  while(state != scored){
+  while(state != over){
   switch(state){
   case welcomeMenu: /*welcome screen before the game starts */
-      drawString5x7(10,20, ("welcome to pong"), COLOR_BLACK, COLOR_WHITE);
-      redrawScreen = 1; 
+      drawImage(0, 0, &splash);
+      drawString5x7(22,screenHeight-20, "press a switch", COLOR_WHITE, COLOR_BLACK);
+      while (!started)
+        frameLoopService(welcomeStep, stillRender);
       state = play;
       break;
   case play: /*play state, continues until score limit is reached */
-    drawString5x7(10,20, ("               "), COLOR_BLACK, COLOR_WHITE);
-    while(leftPoints<6 && rightPoints<6){
-      while (!redrawScreen) { /**<Pause CPU if screen doesn't need updating */
-        P1OUT &= ~GREEN_LED;    /**< Green led off witHo CPU */
-        or_sr(0x10);	      /**< CPU OFF */
-      }
-      P1OUT |= GREEN_LED;       /**< Green led on when CPU on */
-      redrawScreen = 0;
-      movLayerDraw(&ml0, &ballLayer);
-      layerGetBounds(&playerPaddleLayer, &urPaddle);
-      layerGetBounds(&enemyPaddleLayer, &ePaddle);
-      buzzer_set_period(0);   
+    while(leftPoints<WIN_POINTS && rightPoints<WIN_POINTS){
+      frameLoopService(gameStep, gameRender); /**<CPU off until a step is due */
       }
       buzzer_set_period(0);
       state = scored;
@@ -357,9 +332,8 @@ void main()
       
   case scored: /*final screen, reached when score limit is reached */
     buzzer_set_period(0);
-    redrawScreen = 1;
-    drawString5x7(screenWidth/2,screenHeight/2, "Game Over!", COLOR_BLACK, COLOR_WHITE);
-    redrawScreen = 0;
+    drawString5x7(screenWidth/2,OVER_ROW, "Game Over!", COLOR_BLACK, COLOR_WHITE);
+    state = over;
     break;
   default:
      drawString5x7((screenHeight/2),(screenWidth/2), "hmmm", COLOR_BLACK, COLOR_WHITE);
@@ -367,20 +341,15 @@ void main()
   
   }
   }
+  /*the game over screen is static: show only its row, in 8 colors, until input */
+  lcd_powerPolicy(LCD_POWER_IDLE | LCD_POWER_PARTIAL, DIM_STEPS, OVER_ROW, OVER_ROW + 7);
+  for (;;)
+    frameLoopService(gameOverStep, stillRender);
 }
 
-/** Watchdog timer interrupt handler. 15 interrupts/sec */
+/** Watchdog timer interrupt handler: only counts time */
 void wdt_c_handler()
 {
-  static short count = 0;
-  P1OUT |= GREEN_LED;		      /**< Green LED on when cpu on */
-  count ++;
-  u_int switchDisplay = p2sw_read(), i;
-  if (count == 15) {
-    mlAdvance(&ml0, &fieldFence, &urPaddle, &ePaddle, &score, &enemyScore);
-      redrawScreen = 1;
-    count = 0;
-  }
- 
-  P1OUT &= ~GREEN_LED;		    /**< Green LED off when cpu off */
+  lcd_initTick();
+  frameLoopTick();
 }
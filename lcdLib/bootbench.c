@@ -0,0 +1,66 @@
+/** \file bootbench.c
+ *  \brief Times boot to first pixel with lcd_init() and with
+ *  lcd_initBegin()/lcd_initTick().
+ *
+ *  Each run initializes the LCD, does PREP_MS of startup work (standing
+ *  in for building tables and scene state), then draws a pixel.  With
+ *  lcd_init() the work waits for the controller; with lcd_initBegin()
+ *  it runs while the controller resets and wakes.  Times are in ms.
+ */
+#include <msp430.h>
+#include <libTimer.h>
+#include "lcdutils.h"
+#include "lcddraw.h"
+#include "lcdnum.h"
+
+#define REPORT_COL 70		/**< of the results' values */
+
+#ifndef PREP_MS
+#define PREP_MS 150		/**< startup work to overlap with init */
+#endif
+
+/** Stand-in for the application's startup work */
+void prepare()
+{
+  u_int ms;
+  for (ms = 0; ms < PREP_MS; ms++)
+    __delay_cycles(16000);	/**< 1ms at 16MHz */
+}
+
+void main()
+{
+  u_int blocking, async;
+
+  configureClocks();
+  or_sr(0x8);			/**< GIE: stopwatch overflow */
+
+  stopwatchStart();		/* before: prepare after lcd_init */
+  lcd_init();
+  prepare();
+  drawPixel(0, 0, COLOR_WHITE);
+  stopwatchStop();
+  blocking = stopwatchMs();
+
+  enableWDTInterrupts();	/**< lcd_initTick() from here on */
+  stopwatchStart();		/* after: prepare while the LCD wakes */
+  lcd_initBegin();
+  prepare();
+  while (!lcd_ready)
+    ;
+  drawPixel(0, 0, COLOR_WHITE);
+  stopwatchStop();
+  async = stopwatchMs();
+
+  clearScreen(COLOR_BLACK);
+  drawReportLine(0, "prep", PREP_MS, REPORT_COL);
+  drawReportLine(1, "blocking", blocking, REPORT_COL);
+  drawReportLine(2, "async", async, REPORT_COL);
+
+  for (;;)
+    or_sr(0x10);		/**< CPU OFF */
+}
+
+void __interrupt_vec(WDT_VECTOR) WDT()	/* 250 interrupts/sec */
+{
+  lcd_initTick();
+}
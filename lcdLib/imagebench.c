@@ -0,0 +1,51 @@
+/** \file imagebench.c
+ *  \brief Times drawImage decoding the splash screen (splash.ppm).
+ *
+ *  Draws the image REPEAT times, then streams the same number of
+ *  pixels of one color (the SPI's limit).  Reports ms per image and
+ *  throughput in thousands of pixels per second.
+ */
+#include <msp430.h>
+#include <libTimer.h>
+#include "lcdutils.h"
+#include "lcddraw.h"
+#include "lcdnum.h"
+#include "lcdimage.h"
+#include "splash.h"
+
+#define REPORT_COL 90		/**< of the results' values */
+
+#define REPEAT 4
+
+void main()
+{
+  u_char i;
+  u_int pixels = (u_int)splash.width * splash.height, decodeMs, streamMs;
+
+  configureClocks();
+  lcd_init();
+  or_sr(0x8);			/**< GIE: stopwatch overflow */
+
+  stopwatchStart();
+  for (i = 0; i < REPEAT; i++)
+    drawImage(0, 0, &splash);
+  stopwatchStop();
+  decodeMs = stopwatchMs();
+
+  stopwatchStart();
+  for (i = 0; i < REPEAT; i++) {
+    lcd_setArea(0, 0, splash.width - 1, splash.height - 1);
+    lcd_writeColorRun(COLOR_BLACK, pixels);
+  }
+  stopwatchStop();
+  streamMs = stopwatchMs();
+
+  drawImage(0, 0, &splash);
+  drawReportLine(0, "pixels", pixels, REPORT_COL);
+  drawReportLine(1, "image ms", decodeMs / REPEAT, REPORT_COL);
+  drawReportLine(2, "image kpx/s", (unsigned long)REPEAT * pixels / decodeMs, REPORT_COL);
+  drawReportLine(3, "stream kpx/s", (unsigned long)REPEAT * pixels / streamMs, REPORT_COL);
+
+  for (;;)
+    or_sr(0x10);		/**< CPU OFF */
+}
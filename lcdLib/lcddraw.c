@@ -48,70 +48,293 @@ void clearScreen(u_int colorBGR)
   fillRectangle(0, 0, screenWidth, screenHeight, colorBGR);
 }
 
-/** 5x7 font - this function draws background pixels
- *  Adapted from RobG's EduKit
+
+/** Draw rectangle outline
+ *  
+ *  \param colMin Column start
+ *  \param rowMin Row start 
+ *  \param width Width of rectangle
+ *  \param height Height of rectangle
+ *  \param colorBGR Color of rectangle in BGR
  */
-void drawChar5x7(u_char rcol, u_char rrow, char c, 
-     u_int fgColorBGR, u_int bgColorBGR) 
+void drawRectOutline(u_char colMin, u_char rowMin, u_char width, u_char height,
+		     u_int colorBGR)
+{
+  /**< top & bot */
+  fillRectangle(colMin, rowMin, width, 1, colorBGR);
+  fillRectangle(colMin, rowMin + height, width, 1, colorBGR);
+
+  /**< left & right */
+  fillRectangle(colMin, rowMin, 1, height, colorBGR);
+  fillRectangle(colMin + width, rowMin, 1, height, colorBGR);
+}
+
+
+/** Draw a run of pixels along one axis through a single window (private)
+ *
+ *  \param major 0 for a run along a row, 1 for a run along a column
+ *  \param from First column (or row) of the run
+ *  \param to Last column (or row) of the run
+ *  \param at Row (or column) of the run
+ */
+static void drawRun(u_char major, u_char from, u_char to, u_char at,
+		    u_int colorBGR)
+{
+  u_int count = to - from + 1;
+  if (major)
+    lcd_setArea(at, from, at, to);
+  else
+    lcd_setArea(from, at, to, at);
+  while (count--)
+    lcd_writeColor(colorBGR);
+}
+
+/** Draw line
+ *
+ *  Bresenham's algorithm steps along the major axis (columns for 
+ *  shallow lines, rows for steep ones).  Each run of pixels at the same
+ *  minor coordinate is sent through one window, so only runs (not
+ *  pixels) pay for addressing.
+ */
+void drawLine(u_char col0, u_char row0, u_char col1, u_char row1, 
+	      u_int colorBGR)
+{
+  u_char from[2], to[2], major, start, pos, at;
+  int dCol = col1 - col0, dRow = row1 - row0, dMajor, dMinor, err;
+  signed char step = 1;
+
+  if (dCol < 0) dCol = -dCol;
+  if (dRow < 0) dRow = -dRow;
+  major = dRow > dCol;		/* steep: step along rows */
+  if ((major ? row1 < row0 : col1 < col0)) { /* step toward increasing major */
+    from[0] = col1; from[1] = row1; to[0] = col0; to[1] = row0;
+  } else {
+    from[0] = col0; from[1] = row0; to[0] = col1; to[1] = row1;
+  }
+  dMajor = to[major] - from[major];
+  dMinor = to[!major] - from[!major];
+  if (dMinor < 0) {
+    dMinor = -dMinor;
+    step = -1;
+  }
+
+  start = pos = from[major];
+  at = from[!major];
+  err = dMajor >> 1;
+  while (pos != to[major]) {
+    err -= dMinor;
+    if (err < 0) {		/* next pixel is off this run */
+      drawRun(major, start, pos, at, colorBGR);
+      at += step;
+      err += dMajor;
+      start = pos + 1;
+    }
+    pos++;
+  }
+  drawRun(major, start, pos, at, colorBGR);
+}
+
+/** Draw connected lines
+ *
+ *  \param points count (col, row) vertices; line i joins points i and i+1
+ */
+void drawPolyline(const u_char points[][2], u_char count, u_int colorBGR)
+{
+  u_char i;
+  for (i = 1; i < count; i++)
+    drawLine(points[i-1][0], points[i-1][1], points[i][0], points[i][1], 
+	     colorBGR);
+}
+
+/** Font metrics, indexed by font (FONT_SM, FONT_MD, FONT_LG) */
+const u_char fontWidth[] = {5, 8, 11}; /**< columns per glyph */
+const u_char fontHeight[] = {8, 12, 16}; /**< rows per glyph */
+const u_char fontAdvance[] = {6, 8, 11}; /**< columns between glyph origins */
+static const u_char fontGlyphs[] = {96, 95, 95}; /**< glyphs from 0x20 */
+
+/** Bits of one row of a glyph.  
+ *  The leftmost pixel is bit (fontWidth[font] - 1).
+ *
+ *  Every font is stored by row (the 5x7 and 11x16 fonts as transposed
+ *  by makeFontRows), so a glyph row is a single table read.
+ */
+static u_int glyphRowBits(u_char font, char c, u_char row)
 {
-  u_char col = 0;
-  u_char row = 0;
-  u_char bit = 0x01;
   u_char oc = c - 0x20;
+  if (oc >= fontGlyphs[font])
+    oc = 0;			/**< unknown characters are blank */
+  switch (font) {
+  case FONT_MD:			/**< leftmost pixel in bit 7 */
+    return font_8x12[oc][row];
+  case FONT_LG:			/**< leftmost pixel in bit 10 */
+    return font_11x16_rows[oc][row];
+  default:			/**< leftmost pixel in bit 4 */
+    return font_5x7_rows[oc][row];
+  }
+}
 
-  lcd_setArea(rcol, rrow, rcol + 4, rrow + 7); /* relative to requested col/row */
-  while (row < 8) {
-    while (col < 5) {
-      u_int colorBGR = (font_5x7[oc][col] & bit) ? fgColorBGR : bgColorBGR;
-      lcd_writeColor(colorBGR);
-      col++;
+u_int fontRowBits(u_char font, char c, u_char row)
+{
+  return glyphRowBits(font, c, row);
+}
+
+int fontPixel(u_char font, char c, u_char col, u_char row)
+{
+  return glyphRowBits(font, c, row) & (1 << (fontWidth[font] - 1 - col));
+}
+
+/** Number of characters of string that fit on screen starting at col */
+static u_char glyphsOnScreen(u_char font, u_char col, char *string)
+{
+  u_char count = 0;
+  u_int right = col + fontWidth[font];	/**< one past the next glyph */
+  while (string[count] && right <= screenWidth) {
+    count++;
+    right += fontAdvance[font];
+  }
+  return count;
+}
+
+u_char drawGlyphStream(u_char font, u_char col, u_char row, 
+		       CharAt charAt, const void *src, u_char count, 
+		       u_int fgColorBGR, u_int bgColorBGR)
+{
+  u_char width = fontWidth[font], gap = fontAdvance[font] - width;
+  u_char height = fontHeight[font], r, i, b;
+  u_char winWidth = count * fontAdvance[font] - gap;
+  if (!count || row >= screenHeight)
+    return 0;
+  if (row + height > screenHeight)
+    height = screenHeight - row;
+  lcd_setArea(col, row, col + winWidth - 1, row + height - 1);
+  for (r = 0; r < height; r++) {
+    for (i = 0; i < count; i++) {
+      u_int bits = glyphRowBits(font, (*charAt)(src, i), r);
+      u_int mask = 1 << (width - 1);
+      for (; mask; mask >>= 1)
+	lcd_writeColor((bits & mask) ? fgColorBGR : bgColorBGR);
+      if (i + 1 < count)	/**< paint the gap, except after the last glyph */
+	for (b = 0; b < gap; b++)
+	  lcd_writeColor(bgColorBGR);
+    }
+  }
+  return winWidth;
+}
+
+/** CharAt for a string */
+static char stringCharAt(const void *string, u_char index)
+{
+  return ((const char *)string)[index];
+}
+
+/** Stream count glyphs of string through one window (see drawGlyphStream) */
+static u_char drawGlyphs(u_char font, u_char col, u_char row, char *string,
+			 u_char count, u_int fgColorBGR, u_int bgColorBGR)
+{
+  return drawGlyphStream(font, col, row, stringCharAt, string, count,
+			 fgColorBGR, bgColorBGR);
+}
+
+/** Write only the foreground pixels of count glyphs of string, one
+ *  lcd_setArea per horizontal run.
+ */
+static void drawTransparentGlyphs(u_char font, u_char col, u_char row,
+				  char *string, u_char count, u_int fgColorBGR)
+{
+  u_char width = fontWidth[font], height = fontHeight[font], r, i;
+  if (row >= screenHeight)
+    return;
+  if (row + height > screenHeight)
+    height = screenHeight - row;
+  for (r = 0; r < height; r++) {
+    u_char glyphCol = col;
+    for (i = 0; i < count; i++, glyphCol += fontAdvance[font]) {
+      u_int bits = glyphRowBits(font, string[i], r);
+      u_char c = 0;
+      while (bits) {		/**< for each run of set bits, left to right */
+	u_int mask = 1 << (width - 1 - c);
+	u_char start;
+	while (!(bits & mask)) {
+	  mask >>= 1; c++;
+	}
+	start = c;
+	while (bits & mask) {
+	  bits &= ~mask;
+	  mask >>= 1; c++;
+	}
+	lcd_setArea(glyphCol + start, row + r, glyphCol + c - 1, row + r);
+	for (; start < c; start++)
+	  lcd_writeColor(fgColorBGR);
+      }
     }
-    col = 0;
-    bit <<= 1;
-    row++;
   }
 }
 
+/** 5x7 font - this function draws background pixels
+ *  Adapted from RobG's EduKit
+ */
+void drawChar5x7(u_char rcol, u_char rrow, char c, 
+     u_int fgColorBGR, u_int bgColorBGR) 
+{
+  drawGlyphs(FONT_SM, rcol, rrow, &c, 1, fgColorBGR, bgColorBGR);
+}
+
 /** Draw string at col,row
- *  Type:
- *  FONT_SM - small (5x8,) FONT_MD - medium (8x12,) FONT_LG - large (11x16)
- *  FONT_SM_BKG, FONT_MD_BKG, FONT_LG_BKG - as above, but with background color
  *  Adapted from RobG's EduKit
  *
+ *  The string, including the 1-pixel gaps between glyphs, is streamed
+ *  row by row through one lcd_setArea window.
+ *
  *  \param col Column to start drawing string
  *  \param row Row to start drawing string
  *  \param string The string
  *  \param fgColorBGR Foreground color in BGR
  *  \param bgColorBGR Background color in BGR
+ *  \return Width of the rendered string in pixels
  */
-void drawString5x7(u_char col, u_char row, char *string,
+u_char drawString5x7(u_char col, u_char row, char *string,
 		u_int fgColorBGR, u_int bgColorBGR)
 {
-  u_char cols = col;
-  while (*string) {
-    drawChar5x7(cols, row, *string++, fgColorBGR, bgColorBGR);
-    cols += 6;
-  }
+  return drawGlyphs(FONT_SM, col, row, string, 
+		    glyphsOnScreen(FONT_SM, col, string), fgColorBGR, bgColorBGR);
 }
 
+void drawChar8x12(u_char col, u_char row, char c, 
+		  u_int fgColorBGR, u_int bgColorBGR)
+{
+  drawGlyphs(FONT_MD, col, row, &c, 1, fgColorBGR, bgColorBGR);
+}
 
-/** Draw rectangle outline
- *  
- *  \param colMin Column start
- *  \param rowMin Row start 
- *  \param width Width of rectangle
- *  \param height Height of rectangle
- *  \param colorBGR Color of rectangle in BGR
- */
-void drawRectOutline(u_char colMin, u_char rowMin, u_char width, u_char height,
-		     u_int colorBGR)
+u_char drawString8x12(u_char col, u_char row, char *string, 
+		    u_int fgColorBGR, u_int bgColorBGR)
 {
-  /**< top & bot */
-  fillRectangle(colMin, rowMin, width, 1, colorBGR);
-  fillRectangle(colMin, rowMin + height, width, 1, colorBGR);
+  return drawGlyphs(FONT_MD, col, row, string, glyphsOnScreen(FONT_MD, col, string),
+	     fgColorBGR, bgColorBGR);
+}
 
-  /**< left & right */
-  fillRectangle(colMin, rowMin, 1, height, colorBGR);
-  fillRectangle(colMin + width, rowMin, 1, height, colorBGR);
+void drawChar11x16(u_char col, u_char row, char c, 
+		   u_int fgColorBGR, u_int bgColorBGR)
+{
+  drawGlyphs(FONT_LG, col, row, &c, 1, fgColorBGR, bgColorBGR);
+}
+
+u_char drawString11x16(u_char col, u_char row, char *string, 
+		     u_int fgColorBGR, u_int bgColorBGR)
+{
+  return drawGlyphs(FONT_LG, col, row, string, glyphsOnScreen(FONT_LG, col, string),
+	     fgColorBGR, bgColorBGR);
 }
 
+void drawTransparentString8x12(u_char col, u_char row, char *string, 
+			       u_int fgColorBGR)
+{
+  drawTransparentGlyphs(FONT_MD, col, row, string,
+			glyphsOnScreen(FONT_MD, col, string), fgColorBGR);
+}
+
+void drawTransparentString11x16(u_char col, u_char row, char *string, 
+				u_int fgColorBGR)
+{
+  drawTransparentGlyphs(FONT_LG, col, row, string,
+			glyphsOnScreen(FONT_LG, col, string), fgColorBGR);
+}
@@ -30,19 +30,21 @@ void fillRectangle(u_char colMin, u_char rowMin, u_char width, u_char height, u_
 void clearScreen(u_int colorBGR);
 
 /** Draw string at col,row
- *  Type:
- *  FONT_SM - small (5x8,) FONT_MD - medium (8x12,) FONT_LG - large (11x16)
- *  FONT_SM_BKG, FONT_MD_BKG, FONT_LG_BKG - as above, but with background color
  *  Adapted from RobG's EduKit
  *
+ *  The string, including the 1-pixel gaps between glyphs, is streamed
+ *  row by row through one lcd_setArea window.  Characters that would
+ *  extend past the screen's right edge are not drawn.
+ *
  *  \param col Column to start drawing string
  *  \param row Row to start drawing string
  *  \param string The string
  *  \param fgColorBGR Foreground color in BGR
  *  \param bgColorBGR Background color in BGR
+ *  \return Width of the rendered string in pixels
  */
-void drawString5x7(u_char col, u_char row, char *string, 
-		   u_int fgColorBGR, u_int bgColorBGR);
+u_char drawString5x7(u_char col, u_char row, char *string, 
+		     u_int fgColorBGR, u_int bgColorBGR);
 
 /** 5x7 font - this function draws background pixels
  *  Adapted from RobG's EduKit
@@ -50,6 +52,92 @@ void drawString5x7(u_char col, u_char row, char *string,
 void drawChar5x7(u_char col, u_char row, char c, 
 		 u_int fgColorBGR, u_int bgColorBGR);
 
+/** Font identifiers
+ */
+#define FONT_SM 0		/**< 5x7 (font_5x7) */
+#define FONT_MD 1		/**< 8x12 (font_8x12) */
+#define FONT_LG 2		/**< 11x16 (font_11x16) */
+
+/** Font metrics, indexed by font */
+extern const u_char fontWidth[];   /**< columns per glyph */
+extern const u_char fontHeight[];  /**< rows per glyph */
+extern const u_char fontAdvance[]; /**< columns between glyph origins */
+
+/** Bits of one row of a glyph.
+ *  The leftmost pixel is bit (fontWidth[font] - 1).
+ *
+ *  \param font FONT_SM, FONT_MD or FONT_LG
+ *  \param c The character
+ *  \param row Row within the glyph (0 is the top)
+ */
+u_int fontRowBits(u_char font, char c, u_char row);
+
+/** True if pixel col,row of c's glyph is foreground
+ */
+int fontPixel(u_char font, char c, u_char col, u_char row);
+
+/** Supplies the character at index for drawGlyphStream */
+typedef char (*CharAt)(const void *src, u_char index);
+
+/** Draw count characters, obtained from charAt(src, index), at col,row
+ *  (with background).  The glyphs and the gaps between them are
+ *  streamed row by row through one lcd_setArea window, so characters
+ *  can be generated on the fly rather than formatted into a buffer.
+ *  The caller ensures the characters fit on screen.
+ *
+ *  \return Width of the rendered characters in pixels
+ */
+u_char drawGlyphStream(u_char font, u_char col, u_char row, 
+		       CharAt charAt, const void *src, u_char count, 
+		       u_int fgColorBGR, u_int bgColorBGR);
+
+/** 8x12 font - draws background pixels.  
+ *  The glyph is streamed row by row into a single lcd_setArea window.
+ */
+void drawChar8x12(u_char col, u_char row, char c, 
+		  u_int fgColorBGR, u_int bgColorBGR);
+
+/** Draw string at col,row in the 8x12 font (with background)
+ *
+ *  The whole string is streamed row by row through one lcd_setArea
+ *  window.  Characters that would extend past the screen's right edge
+ *  are not drawn.
+ *
+ *  \param col Column to start drawing string
+ *  \param row Row to start drawing string
+ *  \param string The string
+ *  \param fgColorBGR Foreground color in BGR
+ *  \param bgColorBGR Background color in BGR
+ *  \return Width of the rendered string in pixels
+ */
+u_char drawString8x12(u_char col, u_char row, char *string, 
+		      u_int fgColorBGR, u_int bgColorBGR);
+
+/** 11x16 font - draws background pixels.  
+ *  The glyph is streamed row by row into a single lcd_setArea window.
+ */
+void drawChar11x16(u_char col, u_char row, char c, 
+		   u_int fgColorBGR, u_int bgColorBGR);
+
+/** Draw string at col,row in the 11x16 font (with background)
+ *  As drawString8x12.
+ */
+u_char drawString11x16(u_char col, u_char row, char *string, 
+		       u_int fgColorBGR, u_int bgColorBGR);
+
+/** Draw string at col,row in the 8x12 font without a background.  
+ *  Only foreground pixels are written, one lcd_setArea per horizontal
+ *  run of foreground pixels.
+ */
+void drawTransparentString8x12(u_char col, u_char row, char *string, 
+			       u_int fgColorBGR);
+
+/** Draw string at col,row in the 11x16 font without a background.  
+ *  As drawTransparentString8x12.
+ */
+void drawTransparentString11x16(u_char col, u_char row, char *string, 
+				u_int fgColorBGR);
+
 /** Draw rectangle outline
  *  
  *  \param colMin Column start
@@ -60,6 +148,28 @@ void drawChar5x7(u_char col, u_char row, char c,
  */
 void drawRectOutline(u_char colMin, u_char rowMin, u_char width, u_char height,
 		     u_int colorBGR);
+
+/** Draw line between two points (inclusive)
+ *
+ *  Each horizontal (or, for steep lines, vertical) run of the line is 
+ *  drawn through a single lcd_setArea window.
+ *
+ *  \param col0 Column of first point
+ *  \param row0 Row of first point
+ *  \param col1 Column of last point
+ *  \param row1 Row of last point
+ *  \param colorBGR Color of line in BGR
+ */
+void drawLine(u_char col0, u_char row0, u_char col1, u_char row1, 
+	      u_int colorBGR);
+
+/** Draw lines joining a sequence of points
+ *
+ *  \param points (col, row) of each point
+ *  \param count Number of points
+ *  \param colorBGR Color of lines in BGR
+ */
+void drawPolyline(const u_char points[][2], u_char count, u_int colorBGR);
 #endif // included
 
 
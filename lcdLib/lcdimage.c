@@ -0,0 +1,20 @@
+/** \file lcdimage.c
+ *  \brief Streaming decoder for run-length compressed images
+ */
+#include "lcdutils.h"
+#include "lcdimage.h"
+
+void drawImage(u_char col, u_char row, const Image *image)
+{
+  const u_char *runs = image->runs;
+  u_int pixels = (u_int)image->width * image->height;
+  lcd_setArea(col, row, col + image->width - 1, row + image->height - 1);
+  while (pixels) {
+    u_char run = *runs++;
+    u_int length = (run >> 4) + 1;
+    if (length > IMAGE_RUN_LONG)
+      length += *runs++;
+    lcd_writeColorRun(image->palette[run & 0xf], length);
+    pixels -= length;
+  }
+}
@@ -0,0 +1,31 @@
+/** \file lcdimage.h
+ *  \brief Palette-indexed, run-length compressed images, decoded 
+ *  straight into the LCD's pixel stream.
+ */
+
+#ifndef lcdimage_included
+#define lcdimage_included
+
+#include "lcdutils.h"
+
+/** Image runs are bytes (length << 4 | color).  Lengths 0..14 are runs
+ *  of 1..15 pixels; length 15 (IMAGE_RUN_LONG) is a run of 16 plus the
+ *  next byte (16..271 pixels).  Runs continue from the end of one row 
+ *  to the start of the next.
+ */
+#define IMAGE_RUN_LONG 15
+
+/** An image compressed by makeImage (see README.md) */
+typedef struct {
+  u_char width, height;
+  const u_int *palette;		/**< up to 16 BGR colors */
+  const u_char *runs;
+} Image;
+
+/** Draw image with its top left corner at (col, row).  The image is 
+ *  sent through a single window, without a buffer; it must fit on 
+ *  the screen.
+ */
+void drawImage(u_char col, u_char row, const Image *image);
+
+#endif // included
@@ -0,0 +1,125 @@
+/** \file lcdnum.c
+ *  \brief Division-free number formatting for the glyph streamer
+ */
+#include "lcdutils.h"
+#include "lcddraw.h"
+#include "lcdnum.h"
+
+static const u_int powersOfTen[] = {10000, 1000, 100, 10, 1};
+
+void numCharsInit(NumChars *chars, int value, u_char format, u_char width)
+{
+  u_int magnitude = value;
+  u_char digit;
+  chars->negative = (format & NUM_SIGNED) && value < 0;
+  if (chars->negative)
+    magnitude = -magnitude;
+  if (format & NUM_HEX) {
+    chars->digits = magnitude;
+    chars->sigDigits = 4;
+  } else {			/* subtract powers of ten (no divides) */
+    chars->digits = 0;
+    for (digit = 0; digit < 5; digit++) {
+      u_int power = powersOfTen[digit];
+      u_char count = 0;
+      while (magnitude >= power) {
+	magnitude -= power;
+	count++;
+      }
+      chars->digits = (chars->digits << 4) | count;
+    }
+    chars->sigDigits = 5;
+  }
+  while (chars->sigDigits > 1 &&
+	 !((chars->digits >> ((chars->sigDigits - 1) << 2)) & 0xf))
+    chars->sigDigits--;		/* drop leading zeros */
+  chars->format = format;
+  chars->width = width ? width : chars->sigDigits + chars->negative;
+  chars->overflow = chars->width < chars->sigDigits + chars->negative;
+}
+
+char numCharsAt(const void *src, u_char index)
+{
+  const NumChars *chars = src;
+  u_char place = chars->width - 1 - index; /* 0 is the units */
+  if (chars->overflow)
+    return '#';
+  if (place < chars->sigDigits) {
+    u_char digit = (chars->digits >> (place << 2)) & 0xf;
+    return digit < 10 ? '0' + digit : 'a' - 10 + digit;
+  }
+  if (chars->format & NUM_ZEROPAD)
+    return (chars->negative && index == 0) ? '-' : '0';
+  if (chars->negative && place == chars->sigDigits)
+    return '-';
+  return ' ';
+}
+
+u_char drawNumber(u_char col, u_char row, u_char font, int value, 
+		  u_char format, u_char width, u_int fgColorBGR, u_int bgColorBGR)
+{
+  NumChars chars;
+  numCharsInit(&chars, value, format, width);
+  return drawGlyphStream(font, col, row, numCharsAt, &chars, chars.width,
+			 fgColorBGR, bgColorBGR);
+}
+
+void numFieldDraw(NumField *field, int value)
+{
+  drawNumber(field->col, field->row, field->font, value, field->format, 
+	     field->width, field->fgColorBGR, field->bgColorBGR);
+  field->shown = value;
+  field->valid = 1;
+}
+
+/** A run of characters within a field, for drawGlyphStream */
+typedef struct {
+  const NumChars *chars;
+  u_char first;			/**< index of the run's first character */
+} NumRun;
+
+static char numRunAt(const void *src, u_char index)
+{
+  const NumRun *run = src;
+  return numCharsAt(run->chars, run->first + index);
+}
+
+void numFieldUpdate(NumField *field, int value)
+{
+  NumChars now, before;
+  NumRun run;
+  u_char index, advance = fontAdvance[field->font];
+  if (!field->valid) {
+    numFieldDraw(field, value);
+    return;
+  }
+  if (value == field->shown)
+    return;
+  numCharsInit(&now, value, field->format, field->width);
+  numCharsInit(&before, field->shown, field->format, field->width);
+  run.chars = &now;
+  for (index = 0; index < field->width; ) {
+    if (numCharsAt(&now, index) == numCharsAt(&before, index)) {
+      index++;
+      continue;
+    }
+    run.first = index;		/* stream each run of changed characters */
+    while (index < field->width && 
+	   numCharsAt(&now, index) != numCharsAt(&before, index))
+      index++;
+    drawGlyphStream(field->font, field->col + run.first * advance, field->row,
+		    numRunAt, &run, index - run.first, 
+		    field->fgColorBGR, field->bgColorBGR);
+  }
+  field->shown = value;
+}
+
+void drawReportLine(u_char line, char *label, unsigned long value, u_char valueCol)
+{
+  u_char row = 10 * line + 4;
+  drawString5x7(4, row, label, COLOR_WHITE, COLOR_BLACK);
+  if (value > 0xffff)		/* drawNumber shows 16 bits */
+    drawString5x7(valueCol, row, ">65535", COLOR_WHITE, COLOR_BLACK);
+  else
+    drawNumber(valueCol, row, FONT_SM, value, NUM_DEC, 5, COLOR_WHITE, COLOR_BLACK);
+}
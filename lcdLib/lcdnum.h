@@ -0,0 +1,80 @@
+/** \file lcdnum.h
+ *  \brief Numbers rendered straight to glyphs: no sprintf, no buffers,
+ *  no division.
+ */
+
+#ifndef lcdnum_included
+#define lcdnum_included
+
+/** Number formats */
+#define NUM_DEC     0		/**< unsigned decimal */
+#define NUM_SIGNED  1		/**< signed decimal */
+#define NUM_HEX     2		/**< hexadecimal (unsigned) */
+#define NUM_ZEROPAD 4		/**< pad with '0' rather than ' ' (or with format) */
+
+/** The characters of a formatted number, generated on demand
+ *
+ *  The number is right-aligned in a field of width characters.  
+ *  A width of 0 is just wide enough for the number.  Numbers (with 
+ *  their sign) wider than their field fill it with '#' instead.
+ */
+typedef struct {
+  unsigned long digits;		/**< one digit per nibble, units in low nibble */
+  u_char sigDigits;		/**< digits excluding leading zeros (>= 1) */
+  u_char width;			/**< characters in field */
+  u_char format;
+  u_char negative;
+  u_char overflow;		/**< too wide for the field: shown as '#'s */
+} NumChars;
+
+/** Prepare value's characters (at most 5 decimal or 4 hex digits)
+ *
+ *  \param chars (out) The characters
+ *  \param value The number (interpreted as unsigned unless NUM_SIGNED)
+ *  \param format NUM_DEC, NUM_SIGNED or NUM_HEX, optionally | NUM_ZEROPAD
+ *  \param width Field width in characters, or 0
+ */
+void numCharsInit(NumChars *chars, int value, u_char format, u_char width);
+
+/** Character at index (0 is leftmost) of the field.  Matches CharAt. */
+char numCharsAt(const void *chars, u_char index);
+
+/** Draw value at col,row (with background) as one glyph stream
+ *  
+ *  \param font FONT_SM, FONT_MD or FONT_LG
+ *  \return Width of the rendered number in pixels
+ */
+u_char drawNumber(u_char col, u_char row, u_char font, int value, 
+		  u_char format, u_char width, u_int fgColorBGR, u_int bgColorBGR);
+
+/** A number displayed at a fixed place, for counters redrawn often
+ *  (scores, frame rates, timings).
+ *
+ *  Initialize all fields but shown and valid (which should be 0).  
+ *  width must be nonzero.
+ */
+typedef struct {
+  u_char col, row;		/**< top left */
+  u_char font;			/**< FONT_SM, FONT_MD or FONT_LG */
+  u_char format;		/**< as numCharsInit */
+  u_char width;			/**< field width in characters */
+  u_int fgColorBGR, bgColorBGR;
+  int shown;			/**< value on screen */
+  u_char valid;			/**< true once drawn */
+} NumField;
+
+/** Draw the whole field */
+void numFieldDraw(NumField *field, int value);
+
+/** Redraw only the characters that differ from those on screen 
+ *  (everything if the field has not been drawn yet)
+ */
+void numFieldUpdate(NumField *field, int value);
+
+/** Draw one line of a results table (as benchmarks show them): label
+ *  at the left of text line line (10 rows apart) and value (or ">65535")
+ *  at column valueCol, white on black
+ */
+void drawReportLine(u_char line, char *label, unsigned long value, u_char valueCol);
+
+#endif // included
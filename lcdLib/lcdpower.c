@@ -0,0 +1,47 @@
+/** \file lcdpower.c
+ *  \brief Inactivity policy for the LCD's power saving modes
+ */
+#include "lcdutils.h"
+#include "lcdpower.h"
+
+u_char lcd_powerSaving = 0;
+
+static u_char powerMode, partStart, partEnd;
+static u_int powerSteps, quietSteps;
+
+/** Leave every power saving mode in force */
+static void powerRestore()
+{
+  if (lcd_powerSaving & LCD_POWER_IDLE)
+    lcd_idle(0);
+  if (lcd_powerSaving & LCD_POWER_PARTIAL)
+    lcd_normal();
+  lcd_powerSaving = 0;
+}
+
+void lcd_powerPolicy(u_char mode, u_int steps, u_char rowStart, u_char rowEnd)
+{
+  powerRestore();
+  powerMode = mode;
+  powerSteps = steps;
+  partStart = rowStart;
+  partEnd = rowEnd;
+  quietSteps = 0;
+}
+
+void lcd_powerStep(u_char active)
+{
+  if (active) {
+    quietSteps = 0;
+    if (lcd_powerSaving)
+      powerRestore();
+    return;
+  }
+  if (lcd_powerSaving || !powerMode || ++quietSteps < powerSteps)
+    return;
+  if (powerMode & LCD_POWER_PARTIAL)
+    lcd_partial(partStart, partEnd);
+  if (powerMode & LCD_POWER_IDLE)
+    lcd_idle(1);
+  lcd_powerSaving = powerMode;
+}
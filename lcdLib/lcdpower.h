@@ -0,0 +1,35 @@
+/** \file lcdpower.h
+ *  \brief Dims the LCD (idle and/or partial mode) after a while 
+ *  without input, and restores it (without repainting) on input.
+ */
+
+#ifndef lcdpower_included
+#define lcdpower_included
+
+#include "lcdutils.h"
+
+/** Power saving modes (may be or'd) */
+#define LCD_POWER_IDLE    1	/**< 8 colors (see lcd_idle) */
+#define LCD_POWER_PARTIAL 2	/**< only some rows shown (see lcd_partial) */
+
+/** Choose what lcd_powerStep does once input stops
+ *
+ *  \param mode LCD_POWER_IDLE and/or LCD_POWER_PARTIAL (0: never dim)
+ *  \param steps Calls to lcd_powerStep without input before dimming
+ *  \param rowStart First row shown in partial mode
+ *  \param rowEnd Last row shown in partial mode
+ */
+void lcd_powerPolicy(u_char mode, u_int steps, u_char rowStart, u_char rowEnd);
+
+/** Count one step (e.g. of a frame loop) toward dimming, or restore
+ *  the display if there was input.  Sends commands to the LCD, so call
+ *  it where drawing is done (not from an interrupt handler).
+ *
+ *  \param active Nonzero if there was input during this step
+ */
+void lcd_powerStep(u_char active);
+
+/** The modes in force (0 when the display is fully on) */
+extern u_char lcd_powerSaving;
+
+#endif // included
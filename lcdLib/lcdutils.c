@@ -42,12 +42,18 @@ u_char _orientation = 0;
 
 /** LCD driver IC specific defines */
 #define SWRESET							0x01
+#define	SLEEPIN							0x10
 #define	SLEEPOUT						0x11
+#define PTLON							0x12
+#define NORON							0x13
 #define DISPON							0x29
 #define CASETP							0x2A
 #define PASETP							0x2B
 #define RAMWRP							0x2C
+#define PTLAR							0x30
 #define	MADCTL							0x36
+#define IDMOFF							0x38
+#define IDMON							0x39
 #define	COLMOD							0x3A
 #define GMCTRP1							0xE0
 #define GMCTRN1							0xE1
@@ -99,6 +105,60 @@ void lcd_writeColor(u_int colorBGR)
   lcd_writeData(colorU.colorBytes[0]);
 }
 
+void lcd_writeColorRun(u_int colorBGR, u_int count)
+{
+  u_char hi = colorBGR >> 8, lo = colorBGR;
+  while (count--) {
+    lcd_writeData(hi);
+    lcd_writeData(lo);
+  }
+}
+
+/** Send a color's bytes, loading each as soon as the last starts
+ *  shifting out (private: D/C must already be high)
+ */
+static inline void
+lcd_sendColor(u_int colorBGR)
+{
+  while (!(IFG2 & UCB0TXIFG));
+  UCB0TXBUF = colorBGR >> 8;
+  while (!(IFG2 & UCB0TXIFG));
+  UCB0TXBUF = colorBGR;
+}
+
+void lcd_writeColors(const u_int *colors, u_int count)
+{
+  while (UCB0STAT & UCBUSY);	/**< wait for previous transfer to complete */
+  LCD_DC_HI();			/**< all data from here */
+  while (count--)
+    lcd_sendColor(*colors++);
+}
+
+void lcd_writeIndexed(const u_char *indices, u_int count, u_char bpp,
+		      const u_int *palette)
+{
+  u_char b;
+  while (UCB0STAT & UCBUSY);	/**< wait for previous transfer to complete */
+  LCD_DC_HI();			/**< all data from here */
+  if (bpp == 4)
+    for (; count >= 2; count -= 2) {
+      b = *indices++;
+      lcd_sendColor(palette[b >> 4]);
+      lcd_sendColor(palette[b & 0xf]);
+    }
+  else
+    for (; count >= 4; count -= 4) {
+      b = *indices++;
+      lcd_sendColor(palette[b >> 6]);
+      lcd_sendColor(palette[(b >> 4) & 3]);
+      lcd_sendColor(palette[(b >> 2) & 3]);
+      lcd_sendColor(palette[b & 3]);
+    }
+  if (count)			/* a last, partial byte */
+    for (b = *indices; count; count--, b <<= bpp)
+      lcd_sendColor(palette[b >> (8 - bpp)]);
+}
+
 /** Write command to LCD (private) */
 void _writeCommand(u_char command) 
 {
@@ -131,14 +191,27 @@ void lcd_setArea(u_char colStart, u_char rowStart, u_char colEnd, u_char rowEnd)
 	_writeCommand(RAMWRP);
 }
 
-/** Initialize onboard LCD */
-void lcd_init() 
+u_char volatile lcd_ready = 0;
+
+static volatile u_char initState; /**< next step of initialization */
+static volatile u_char initWait; /**< WDT ticks until the next step */
+
+/** Perform the next step of initialization (private)
+ *
+ *  \return Delay (in units of 10ms) the controller needs before the 
+ *  next step, or 0 when initialization is complete
+ */
+static u_char lcd_initStep()
 {
-  setUpSPIforLCD();
-  _writeCommand(SWRESET);  /**< software reset */
-  _delay(20);
-  _writeCommand(SLEEPOUT); /**< exit sleep */
-  _delay(20);
+  switch (initState++) {
+  case 0:
+    setUpSPIforLCD();
+    _writeCommand(SWRESET);  /**< software reset */
+    return 20;
+  case 1:
+    _writeCommand(SLEEPOUT); /**< exit sleep */
+    return 20;
+  }
   _writeCommand(COLMOD);   /**< Set Color Format 16bit */
   lcd_writeData(0x05);
   _writeCommand(DISPON);   /**< display ON */
@@ -157,5 +230,71 @@ void lcd_init()
   default:
     lcd_writeData(0xC8);
   }
+  lcd_ready = 1;
+  return 0;
+}
+
+/** Initialize onboard LCD */
+void lcd_init() 
+{
+  u_char wait;
+  initState = 0;
+  while ((wait = lcd_initStep()))
+    _delay(wait);
+}
+
+void lcd_initBegin()
+{
+  u_char wait;
+  initWait = 0xff;		/**< ticks meanwhile only count down */
+  initState = 0;
+  wait = lcd_initStep();
+  initWait = (wait * 5) >> 1;	/**< 10ms units to 4ms WDT ticks */
+  lcd_ready = 0;		/**< last: ticks may step from here */
+}
+
+void lcd_initTick()
+{
+  u_char wait;
+  if (lcd_ready)
+    return;
+  if (initWait) {
+    initWait--;
+    return;
+  }
+  wait = lcd_initStep();
+  initWait = (wait * 5) >> 1;
+}
+
+void lcd_sleep()
+{
+  _writeCommand(SLEEPIN);
+}
+
+void lcd_wake()
+{
+  _writeCommand(SLEEPOUT);
+  initState = 2;		/**< then resend the configuration */
+  initWait = 30;		/**< 120ms */
+  lcd_ready = 0;		/**< last: ticks may step from here */
+}
+
+void lcd_idle(u_char on)
+{
+  _writeCommand(on ? IDMON : IDMOFF);
+}
+
+void lcd_partial(u_char rowStart, u_char rowEnd)
+{
+  _writeCommand(PTLAR);
+  lcd_writeData(0);
+  lcd_writeData(rowStart);
+  lcd_writeData(0);
+  lcd_writeData(rowEnd);
+  _writeCommand(PTLON);
 }
 
+void lcd_normal()
+{
+  _writeCommand(NORON);
+}
@@ -13,6 +13,10 @@ typedef unsigned int u_int;
 extern const unsigned char font_5x7[96][5];
 extern const unsigned char font_8x12[95][12];
 extern const unsigned int font_11x16[95][11];
+/** The 5x7 and 11x16 fonts by row (leftmost pixel in the top bit),
+ *  generated from the column tables by makeFontRows */
+extern const unsigned char font_5x7_rows[96][8];
+extern const unsigned int font_11x16_rows[95][16];
 
 extern const unsigned int colors[43];
 
@@ -38,9 +42,51 @@ extern const unsigned int colors[43];
 # define screenWidth LONG_EDGE_PIXELS
 #endif
 
-/** Initialize the onboard LCD */
+/** Initialize the onboard LCD (busy-waits about 400ms while the
+ *  controller resets and wakes)
+ */
 void lcd_init();
 
+/** Start initializing the onboard LCD without waiting: the remaining
+ *  steps are performed by lcd_initTick() once the controller is ready
+ *  for them.  Nothing may be drawn until lcd_ready is set.
+ */
+void lcd_initBegin();
+
+/** Continue initialization begun by lcd_initBegin().  Call from the
+ *  watchdog interrupt handler (at 250 Hz); does nothing once lcd_ready.
+ */
+void lcd_initTick();
+
+/** True once initialization is complete */
+extern volatile u_char lcd_ready;
+
+/** Put the LCD to sleep: the panel goes blank and its drivers stop,
+ *  but the frame memory (and drawing into it) still works.  Must not
+ *  follow lcd_wake() (or initialization) by less than 120ms.
+ */
+void lcd_sleep();
+
+/** Wake the LCD from lcd_sleep(), showing the frame memory as it was.
+ *  Clears lcd_ready until lcd_initTick() sets it 120ms later.
+ */
+void lcd_wake();
+
+/** Idle mode: when on, only 8 colors (the high bit of each of red,
+ *  green and blue) are shown, which draws less power.  The frame memory
+ *  keeps full color, so turning it off restores the screen.
+ */
+void lcd_idle(u_char on);
+
+/** Partial mode: only rows rowStart..rowEnd are shown (the rest of the
+ *  panel is blank, and not driven).  Rows are as addressed by
+ *  lcd_setArea in the vertical orientations.
+ */
+void lcd_partial(u_char rowStart, u_char rowEnd);
+
+/** Leave partial mode: the whole frame memory is shown again */
+void lcd_normal();
+
 /** Set area to draw to
  *  
  *  \param colStart Start column of the area
@@ -56,6 +102,33 @@ void lcd_setArea(u_char colStart, u_char rowStart, u_char colEnd, u_char rowEnd)
  */
 void lcd_writeColor(u_int colorBGR);
 
+/** Write count pixels of one color to LCD (without a call per pixel)
+ *
+ *  \param colorBGR The color in BGR
+ *  \param count Number of pixels
+ */
+void lcd_writeColorRun(u_int colorBGR, u_int count);
+
+/** Write count pixels from a buffer of colors to LCD in one tight
+ *  loop (each byte is loaded while the one before it is shifted out)
+ *
+ *  \param colors The colors in BGR
+ *  \param count Number of pixels
+ */
+void lcd_writeColors(const u_int *colors, u_int count);
+
+/** Write count pixels of packed palette indices to LCD, looking each
+ *  up in palette as it is sent
+ *
+ *  \param indices bpp bits per pixel, the leftmost pixel of each byte 
+ *  in its high bits
+ *  \param count Number of pixels
+ *  \param bpp 2 or 4
+ *  \param palette The colors in BGR
+ */
+void lcd_writeIndexed(const u_char *indices, u_int count, u_char bpp,
+		      const u_int *palette);
+
 #define rgb2bgr(val) ((((val) << 11)&0xf800) | ((val)&0x7e0) | (((val)>>11)&0x1f))
 
 /** Colors */
@@ -0,0 +1,84 @@
+/** \file linebench.c
+ *  \brief Times drawLine against a drawPixel per point.
+ *
+ *  Draws a fan of shallow lines (center to the left and right edges)
+ *  and a fan of steep lines (center to the top and bottom edges), each
+ *  with drawLine and with the same Bresenham steps calling drawPixel.
+ *  Times are in ms.
+ */
+#include <msp430.h>
+#include <libTimer.h>
+#include "lcdutils.h"
+#include "lcddraw.h"
+#include "lcdnum.h"
+
+#define REPORT_COL 90		/**< of the results' values */
+
+#define CENTER_COL (screenWidth/2)
+#define CENTER_ROW (screenHeight/2)
+#define FAN_STEP 8		/**< between line ends along an edge */
+
+/** Bresenham's algorithm, a drawPixel per point */
+void pixelLine(u_char col0, u_char row0, u_char col1, u_char row1,
+	       u_int colorBGR)
+{
+  int dCol = col1 > col0 ? col1 - col0 : col0 - col1;
+  int dRow = row1 > row0 ? row1 - row0 : row0 - row1;
+  signed char colStep = col1 > col0 ? 1 : -1, rowStep = row1 > row0 ? 1 : -1;
+  int err = dCol - dRow, err2;
+  for (;;) {
+    drawPixel(col0, row0, colorBGR);
+    if (col0 == col1 && row0 == row1)
+      return;
+    err2 = err << 1;
+    if (err2 > -dRow) { err -= dRow; col0 += colStep; }
+    if (err2 < dCol) { err += dCol; row0 += rowStep; }
+  }
+}
+
+typedef void (*LineFn)(u_char col0, u_char row0, u_char col1, u_char row1,
+		       u_int colorBGR);
+
+/** Time lines from the center to the left & right (or top & bottom)
+ *  edges, in ms
+ */
+u_int fan(LineFn line, u_char steep, u_int colorBGR)
+{
+  u_char i;
+  stopwatchStart();
+  if (steep)
+    for (i = 0; i < screenWidth; i += FAN_STEP) {
+      line(CENTER_COL, CENTER_ROW, i, 0, colorBGR);
+      line(CENTER_COL, CENTER_ROW, i, screenHeight-1, colorBGR);
+    }
+  else
+    for (i = 0; i < screenHeight; i += FAN_STEP) {
+      line(CENTER_COL, CENTER_ROW, 0, i, colorBGR);
+      line(CENTER_COL, CENTER_ROW, screenWidth-1, i, colorBGR);
+    }
+  stopwatchStop();
+  return stopwatchMs();
+}
+
+void main()
+{
+  u_int shallowPixels, shallowLines, steepPixels, steepLines;
+
+  configureClocks();
+  lcd_init();
+  or_sr(0x8);			/**< GIE: stopwatch overflow */
+  clearScreen(COLOR_BLACK);
+
+  shallowPixels = fan(pixelLine, 0, COLOR_RED);
+  shallowLines = fan(drawLine, 0, COLOR_GREEN);
+  steepPixels = fan(pixelLine, 1, COLOR_RED);
+  steepLines = fan(drawLine, 1, COLOR_GREEN);
+
+  drawReportLine(0, "shallow pixels", shallowPixels, REPORT_COL);
+  drawReportLine(1, "shallow lines", shallowLines, REPORT_COL);
+  drawReportLine(2, "steep pixels", steepPixels, REPORT_COL);
+  drawReportLine(3, "steep lines", steepLines, REPORT_COL);
+
+  for (;;)
+    or_sr(0x10);		/**< CPU OFF */
+}
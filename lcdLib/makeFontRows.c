@@ -0,0 +1,49 @@
+// Generate fontrows.c: the 5x7 and 11x16 fonts (stored by column)
+// transposed into one mask per glyph row, so that drawing a glyph row
+// is a single table read rather than a gather from every column
+#include <stdio.h>
+#include <assert.h>
+#include "lcdutils.h"
+
+/** Emit name[glyphs][rows] of row masks, leftmost pixel in the top bit */
+static void emitRows(FILE *fp, const char *type, const char *name,
+		     int glyphs, int rows, int cols, int digits,
+		     unsigned int (*column)(int glyph, int col))
+{
+  int glyph, row, col;
+  fprintf(fp, "const %s %s[%d][%d] = {\n", type, name, glyphs, rows);
+  for (glyph = 0; glyph < glyphs; glyph++) {
+    fprintf(fp, "  {");
+    for (row = 0; row < rows; row++) {
+      unsigned int bits = 0;
+      for (col = 0; col < cols; col++)
+	bits = (bits << 1) | ((column(glyph, col) >> row) & 1);
+      fprintf(fp, "%s0x%0*x", row ? ", " : " ", digits, bits);
+    }
+    fprintf(fp, " }, // %02x\n", glyph + 0x20);
+  }
+  fprintf(fp, "};\n");
+}
+
+static unsigned int column5x7(int glyph, int col)
+{
+  return font_5x7[glyph][col];
+}
+
+static unsigned int column11x16(int glyph, int col)
+{
+  return font_11x16[glyph][col];
+}
+
+int main()
+{
+  FILE *fp = fopen("fontrows.c", "w");
+  assert(fp);
+  fprintf(fp, "// Automatically generated by makeFontRows.\n");
+  fprintf(fp, "#include \"lcdutils.h\"\n\n");
+  emitRows(fp, "unsigned char", "font_5x7_rows", 96, 8, 5, 2, column5x7);
+  fprintf(fp, "\n");
+  emitRows(fp, "unsigned int", "font_11x16_rows", 95, 16, 11, 4, column11x16);
+  fclose(fp);
+  return 0;
+}
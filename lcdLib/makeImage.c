@@ -0,0 +1,151 @@
+/** \file makeImage.c
+ *  \brief Host tool: compresses a PPM image into an Image (lcdimage.h).
+ *
+ *  usage: makeImage name image.ppm
+ *
+ *  Reads a plain (P3) or raw (P6) PPM image of at most 16 colors
+ *  (after conversion to the LCD's 16-bit BGR) and writes name.c,
+ *  holding its palette and runs, and name.h, declaring it.  Reports
+ *  the compressed size against 2 bytes per pixel.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#define MAX_COLORS 16
+#define MAX_RUN 271		/* 16 + 255: see IMAGE_RUN_LONG */
+
+/* next number of a PPM header, skipping comments */
+static int
+ppmInt(FILE *fp)
+{
+  int c, n;
+  while ((c = getc(fp)) == '#' || c == ' ' || c == '\t' || c == '\r' || c == '\n')
+    if (c == '#')
+      while ((c = getc(fp)) != '\n' && c != EOF)
+	;
+  ungetc(c, fp);
+  return fscanf(fp, "%d", &n) == 1 ? n : -1;
+}
+
+/* next sample of a pixel, scaled to 0..255; -1 at end of file */
+static int
+ppmSample(FILE *fp, int raw, int maxval)
+{
+  int v = raw ? getc(fp) : ppmInt(fp);
+  if (v < 0)
+    return -1;
+  return v * 255 / maxval;
+}
+
+static unsigned palette[MAX_COLORS];
+static int colors;
+
+/* palette index of BGR color, adding it if new */
+static int
+colorIndex(unsigned bgr)
+{
+  int i;
+  for (i = 0; i < colors; i++)
+    if (palette[i] == bgr)
+      return i;
+  if (colors == MAX_COLORS) {
+    fprintf(stderr, "makeImage: more than %d colors (reduce them first, e.g. with pnmquant %d)\n",
+	    MAX_COLORS, MAX_COLORS);
+    exit(1);
+  }
+  palette[colors] = bgr;
+  return colors++;
+}
+
+static int bytes, runs;		/* written */
+
+/* write a run of length pixels of color index */
+static void
+emitRun(FILE *fp, int index, int length)
+{
+  if (runs++ % 10 == 0)
+    fprintf(fp, "\n   ");
+  if (length <= 15) {
+    fprintf(fp, " 0x%02x,", (length - 1) << 4 | index);
+    bytes++;
+  } else {
+    fprintf(fp, " 0x%02x, %d,", 15 << 4 | index, length - 16);
+    bytes += 2;
+  }
+}
+
+int
+main(int argc, char **argv)
+{
+  FILE *in, *out;
+  char filename[300];
+  int width, height, maxval, raw, pixel, pixels, runIndex = -1, runLength = 0;
+
+  if (argc != 3) {
+    fprintf(stderr, "usage: %s name image.ppm\n", argv[0]);
+    return 1;
+  }
+  in = fopen(argv[2], "rb");
+  if (!in || getc(in) != 'P' || ((raw = getc(in)) != '6' && raw != '3')) {
+    fprintf(stderr, "makeImage: %s is not a PPM image\n", argv[2]);
+    return 1;
+  }
+  raw = raw == '6';
+  width = ppmInt(in);
+  height = ppmInt(in);
+  maxval = ppmInt(in);
+  if (width <= 0 || width > 255 || height <= 0 || height > 255 || maxval <= 0 || maxval > 255) {
+    fprintf(stderr, "makeImage: %s: need at most 255x255 pixels, 8 bit samples\n", argv[2]);
+    return 1;
+  }
+  if (raw)
+    getc(in);			/* the single whitespace before the pixels */
+
+  sprintf(filename, "%s.c", argv[1]);
+  out = fopen(filename, "w");
+  assert(out);
+  fprintf(out, "// Automatically generated by makeImage from %s\n", argv[2]);
+  fprintf(out, "#include \"lcdimage.h\"\n\n");
+  fprintf(out, "static const u_char runs[] = {");
+  pixels = width * height;
+  for (pixel = 0; pixel < pixels; pixel++) {
+    int r = ppmSample(in, raw, maxval), g = ppmSample(in, raw, maxval), b = ppmSample(in, raw, maxval);
+    int index;
+    if (b < 0) {
+      fprintf(stderr, "makeImage: %s is truncated\n", argv[2]);
+      return 1;
+    }
+    index = colorIndex((b >> 3) << 11 | (g >> 2) << 5 | (r >> 3));
+    if (index == runIndex && runLength < MAX_RUN) {
+      runLength++;
+      continue;
+    }
+    if (runLength)
+      emitRun(out, runIndex, runLength);
+    runIndex = index;
+    runLength = 1;
+  }
+  emitRun(out, runIndex, runLength);
+  fprintf(out, "\n};\n\n");
+  fprintf(out, "static const u_int palette[%d] = {", colors);
+  for (pixel = 0; pixel < colors; pixel++)
+    fprintf(out, "%s0x%04x", pixel ? ", " : "", palette[pixel]);
+  fprintf(out, "};\n\n");
+  fprintf(out, "const Image %s = {%d, %d, palette, runs};\n", argv[1], width, height);
+  fclose(out);
+
+  sprintf(filename, "%s.h", argv[1]);
+  out = fopen(filename, "w");
+  assert(out);
+  fprintf(out, "// Automatically generated by makeImage from %s\n", argv[2]);
+  fprintf(out, "#ifndef %s_included\n#define %s_included\n\n", argv[1], argv[1]);
+  fprintf(out, "#include \"lcdimage.h\"\n\n");
+  fprintf(out, "extern const Image %s;\n\n#endif // included\n", argv[1]);
+  fclose(out);
+
+  printf("%s: %dx%d, %d colors, %d runs: %d bytes (%d uncompressed)\n", argv[1],
+	 width, height, colors, runs, bytes + 2 * colors + 6, 2 * pixels);
+  return 0;
+}
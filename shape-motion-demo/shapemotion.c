@@ -5,11 +5,14 @@
  *  While the CPU is running the green LED is on, and
  *  when the screen does not need to be redrawn the CPU
  *  is turned off along with the green LED.
+ *  Shapes move at a fixed rate however long rendering takes;
+ *  the number of frames dropped is shown at the top left.
  */  
 #include <msp430.h>
 #include <libTimer.h>
 #include <lcdutils.h>
 #include <lcddraw.h>
+#include <lcdnum.h>
 #include <p2switches.h>
 #include <shape.h>
 #include <abCircle.h>
@@ -17,11 +20,11 @@
 #define GREEN_LED BIT6
 
 
-AbRect rect10 = {abRectGetBounds, abRectCheck, {10,10}}; /**< 10x10 rectangle */
-AbRArrow rightArrow = {abRArrowGetBounds, abRArrowCheck, 30};
+AbRect rect10 = {abRectGetBounds, abRectCheck, abRectRowSpans, {10,10}}; /**< 10x10 rectangle */
+AbRArrow rightArrow = {abRArrowGetBounds, abRArrowCheck, abRArrowRowSpans, 30};
 
 AbRectOutline fieldOutline = {	/* playing field */
-  abRectOutlineGetBounds, abRectOutlineCheck,   
+  abRectOutlineGetBounds, abRectOutlineCheck, abRectOutlineRowSpans,
   {screenWidth/2 - 10, screenHeight/2 - 10}
 };
 
@@ -67,59 +70,10 @@ Layer layer0 = {		/**< Layer with an orange circle */
   &layer1,
 };
 
-/** Moving Layer
- *  Linked list of layer references
- *  Velocity represents one iteration of change (direction & magnitude)
- */
-typedef struct MovLayer_s {
-  Layer *layer;
-  Vec2 velocity;
-  struct MovLayer_s *next;
-} MovLayer;
-
 /* initial value of {0,0} will be overwritten */
-MovLayer ml3 = { &layer3, {1,1}, 0 }; /**< not all layers move */
-MovLayer ml1 = { &layer1, {1,2}, &ml3 }; 
-MovLayer ml0 = { &layer0, {2,1}, &ml1 }; 
-
-void movLayerDraw(MovLayer *movLayers, Layer *layers)
-{
-  int row, col;
-  MovLayer *movLayer;
-
-  and_sr(~8);			/**< disable interrupts (GIE off) */
-  for (movLayer = movLayers; movLayer; movLayer = movLayer->next) { /* for each moving layer */
-    Layer *l = movLayer->layer;
-    l->posLast = l->pos;
-    l->pos = l->posNext;
-  }
-  or_sr(8);			/**< disable interrupts (GIE on) */
-
-
-  for (movLayer = movLayers; movLayer; movLayer = movLayer->next) { /* for each moving layer */
-    Region bounds;
-    layerGetBounds(movLayer->layer, &bounds);
-    lcd_setArea(bounds.topLeft.axes[0], bounds.topLeft.axes[1], 
-		bounds.botRight.axes[0], bounds.botRight.axes[1]);
-    for (row = bounds.topLeft.axes[1]; row <= bounds.botRight.axes[1]; row++) {
-      for (col = bounds.topLeft.axes[0]; col <= bounds.botRight.axes[0]; col++) {
-	Vec2 pixelPos = {col, row};
-	u_int color = bgColor;
-	Layer *probeLayer;
-	for (probeLayer = layers; probeLayer; 
-	     probeLayer = probeLayer->next) { /* probe all layers, in order */
-	  if (abShapeCheck(probeLayer->abShape, &probeLayer->pos, &pixelPos)) {
-	    color = probeLayer->color;
-	    break; 
-	  } /* if probe check */
-	} // for checking all layers at col, row
-	lcd_writeColor(color); 
-      } // for col
-    } // for row
-  } // for moving layer being updated
-}	  
-
-
+MovLayer ml3 = { &layer3, {MOV_ONE*3/4, MOV_ONE/2}, 0 }; /**< not all layers move */
+MovLayer ml1 = { &layer1, {MOV_ONE, 2*MOV_ONE}, &ml3 }; 
+MovLayer ml0 = { &layer0, {2*MOV_ONE, MOV_ONE}, &ml1 }; 
 
 //Region fence = {{10,30}, {SHORT_EDGE_PIXELS-10, LONG_EDGE_PIXELS-10}}; /**< Create a fence region */
 
@@ -130,29 +84,51 @@ void movLayerDraw(MovLayer *movLayers, Layer *layers)
  */
 void mlAdvance(MovLayer *ml, Region *fence)
 {
-  Vec2 newPos;
+  Vec2 newPos, step;
   u_char axis;
   Region shapeBoundary;
   for (; ml; ml = ml->next) {
-    vec2Add(&newPos, &ml->layer->posNext, &ml->velocity);
+    movLayerStep(ml, &step);	/**< whole pixels moved this step */
+    vec2Add(&newPos, &ml->layer->posNext, &step);
     abShapeGetBounds(ml->layer->abShape, &newPos, &shapeBoundary);
     for (axis = 0; axis < 2; axis ++) {
       if ((shapeBoundary.topLeft.axes[axis] < fence->topLeft.axes[axis]) ||
 	  (shapeBoundary.botRight.axes[axis] > fence->botRight.axes[axis]) ) {
-	int velocity = ml->velocity.axes[axis] = -ml->velocity.axes[axis];
-	newPos.axes[axis] += (2*velocity);
+	ml->velocity.axes[axis] = -ml->velocity.axes[axis]; /**< back within */
       }	/**< if outside of fence */
     } /**< for axis */
-    ml->layer->posNext = newPos;
+    movLayerMove(ml);
   } /**< for ml */
 }
 
 
 u_int bgColor = COLOR_BLUE;     /**< The background color */
-int redrawScreen = 1;           /**< Boolean for whether screen needs to be redrawn */
 
 Region fieldFence;		/**< fence around playing field  */
 
+NumField dropField = {		/**< frames dropped, above the field */
+  2, 1, FONT_SM, NUM_DEC, 5, COLOR_WHITE, COLOR_BLUE
+};
+
+/** One simulation step: move the shapes */
+void step()
+{
+  P1OUT |= GREEN_LED;		/**< Green led on when CPU on */
+  mlAdvance(&ml0, &fieldFence);
+}
+
+/** Draw the shapes where the last step left them, and the count of 
+ *  frames dropped so far
+ */
+void render()
+{
+  int painting = layerDrawStep(16); /**< the first screen, a band per frame */
+  movLayerDraw(&ml0, &layer0);
+  if (!painting)		/**< (painting would cover it) */
+    numFieldUpdate(&dropField, frameDrops);
+  P1OUT &= ~GREEN_LED;		/**< Green led off when CPU off */
+}
+
 
 /** Initializes everything, enables interrupts and green LED, 
  *  and handles the rendering for the screen
@@ -170,38 +146,22 @@ void main()
   shapeInit();
 
   layerInit(&layer0);
-  layerDraw(&layer0);
+  layerDrawBegin(&layer0);	/**< painted by render() as shapes start moving */
 
 
   layerGetBounds(&fieldLayer, &fieldFence);
 
 
+  frameLoopInit(15);		/**< a step every 15 interrupts */
   enableWDTInterrupts();      /**< enable periodic interrupt */
   or_sr(0x8);	              /**< GIE (enable interrupts) */
 
-
-  for(;;) { 
-    while (!redrawScreen) { /**< Pause CPU if screen doesn't need updating */
-      P1OUT &= ~GREEN_LED;    /**< Green led off witHo CPU */
-      or_sr(0x10);	      /**< CPU OFF */
-    }
-    P1OUT |= GREEN_LED;       /**< Green led on when CPU on */
-    redrawScreen = 0;
-    movLayerDraw(&ml0, &layer0);
-  }
+  for(;;)
+    frameLoopService(step, render); /**< CPU off until a step is due */
 }
 
-/** Watchdog timer interrupt handler. 15 interrupts/sec */
+/** Watchdog timer interrupt handler: only counts time */
 void wdt_c_handler()
 {
-  static short count = 0;
-  P1OUT |= GREEN_LED;		      /**< Green LED on when cpu on */
-  count ++;
-  if (count == 15) {
-    mlAdvance(&ml0, &fieldFence);
-    if (p2sw_read())
-      redrawScreen = 1;
-    count = 0;
-  } 
-  P1OUT &= ~GREEN_LED;		    /**< Green LED off when cpu off */
+  frameLoopTick();
 }
@@ -7,7 +7,7 @@
 	.text
 	
 
-	.extern redrawScreen
+	.extern frameStepsPending
 	.extern wdt_c_handler
 WDT:
 ; start of function
@@ -47,7 +47,7 @@ WDT:
 	POP	R13
 	POP	R14
 	POP	R15
-	cmp	#0, &redrawScreen
+	cmp	#0, &frameStepsPending
 	jz	ball_no_move
 	and	#0xffef, 0(r1)	; clear CPU off in saved SR
 ball_no_move:	
@@ -0,0 +1,60 @@
+#include "shape.h"
+
+void
+abBitmapGetBounds(const AbBitmap *bitmap, const Vec2 *centerPos, Region *bounds)
+{
+  bounds->topLeft.axes[0] = centerPos->axes[0] - bitmap->originCol;
+  bounds->topLeft.axes[1] = centerPos->axes[1] - bitmap->originRow;
+  bounds->botRight.axes[0] = bounds->topLeft.axes[0] + bitmap->width - 1;
+  bounds->botRight.axes[1] = bounds->topLeft.axes[1] + bitmap->height - 1;
+  regionClipScreen(bounds);
+}
+
+int
+abBitmapCheck(const AbBitmap *bitmap, const Vec2 *centerPos, const Vec2 *pixel)
+{
+  int col = pixel->axes[0] - centerPos->axes[0] + bitmap->originCol;
+  int row = pixel->axes[1] - centerPos->axes[1] + bitmap->originRow;
+  if (col < 0 || row < 0 || col >= bitmap->width || row >= bitmap->height)
+    return 0;
+  return bitmap->bits[row * ((bitmap->width + 7) >> 3) + (col >> 3)] & (0x80 >> (col & 7));
+}
+
+void
+abBitmapRowSpans(const AbBitmap *bitmap, const Vec2 *centerPos, int row, SpanFn emit, void *ctx)
+{
+  int left = centerPos->axes[0] - bitmap->originCol;
+  int col, start = -1;		/* start of the run being scanned, or -1 */
+  const u_char *bits;
+  u_char byte;
+  row = row - centerPos->axes[1] + bitmap->originRow;
+  if (row < 0 || row >= bitmap->height)
+    return;
+  if (bitmap->rowIndex) {	/* runs: as an indexed AbSpanTable */
+    const u_char *span = bitmap->spans + 2 * bitmap->rowIndex[row];
+    const u_char *limit = bitmap->spans + 2 * bitmap->rowIndex[row + 1];
+    for (; span < limit; span += 2)
+      (*emit)(ctx, left + span[0], left + span[1]);
+    return;
+  }
+  bits = bitmap->bits + row * ((bitmap->width + 7) >> 3);
+  for (col = 0; col < bitmap->width; col++) {
+    if (!(col & 7)) {
+      byte = *bits++;
+      if (byte == (start < 0 ? 0 : 0xff)) { /* no edge in these 8 pixels */
+	col += 7;
+	continue;
+      }
+    }
+    if (byte & 0x80) {
+      if (start < 0)
+	start = col;
+    } else if (start >= 0) {
+      (*emit)(ctx, left + start, left + col - 1);
+      start = -1;
+    }
+    byte <<= 1;
+  }
+  if (start >= 0)
+    (*emit)(ctx, left + start, left + bitmap->width - 1);
+}
@@ -0,0 +1,113 @@
+/** \file collidebench.c
+ *  \brief Times collisionStep with OBJECTS squares bouncing off each 
+ *  other and a fence.
+ *
+ *  Times STEPS collision steps alone, then STEPS frames of collision
+ *  steps and movLayerDraw (in stopwatch ticks).  Also shows the pairs
+ *  tested exactly by the broadphase, against every pair each step.
+ *  Each object costs 44 bytes of RAM, which limits OBJECTS.
+ */
+#include <msp430.h>
+#include <libTimer.h>
+#include <lcdutils.h>
+#include <lcddraw.h>
+#include <lcdnum.h>
+#include "shape.h"
+
+#define REPORT_COL 70		/**< of the results' values */
+
+#ifndef OBJECTS
+#define OBJECTS 6
+#endif
+#define STEPS 50
+
+#define SQUARE 1		/**< collision group */
+
+u_int bgColor = COLOR_BLACK;
+
+AbRect square = {abRectGetBounds, abRectCheck, abRectRowSpans, {2,2}}; /**< 5x5 */
+
+AbRectOutline fieldOutline = {	/* playing field */
+  abRectOutlineGetBounds, abRectOutlineCheck, abRectOutlineRowSpans,
+  {screenWidth/2 - 2, screenHeight/2 - 2}
+};
+
+Layer fieldLayer = {		/* playing field as a layer */
+  (AbShape *) &fieldOutline,
+  {screenWidth/2, screenHeight/2},/**< center */
+  {0,0}, {0,0},				    /* last & next pos */
+  COLOR_WHITE,
+  0
+};
+
+Layer layers[OBJECTS];
+MovLayer movers[OBJECTS];
+Collider colliders[OBJECTS];
+Region fieldFence;
+CollisionWorld world = { 0, &fieldFence, 0 };
+
+const u_int colors[] = {COLOR_RED, COLOR_GREEN, COLOR_YELLOW, COLOR_CYAN, COLOR_ORANGE, COLOR_MAGENTA};
+
+/** Place the squares on a grid with assorted velocities */
+void sceneInit()
+{
+  u_char i;
+  for (i = 0; i < OBJECTS; i++) {
+    Layer *l = &layers[i];
+    l->abShape = (AbShape *)&square;
+    l->pos.axes[0] = 16 + (i & 3) * 28;
+    l->pos.axes[1] = 20 + (i >> 2) * 24;
+    l->color = colors[i % (sizeof(colors) / sizeof(colors[0]))];
+    l->next = i ? &layers[i-1] : &fieldLayer;
+    movers[i].layer = l;
+    movers[i].velocity.axes[0] = ((i % 3) + 1) * MOV_ONE * 2/3; /* in 1/MOV_ONE pixels */
+    movers[i].velocity.axes[1] = (i & 1) ? -2*MOV_ONE : 3*MOV_ONE;
+    movers[i].next = i ? &movers[i-1] : 0;
+    colliders[i].layer = l;
+    colliders[i].mover = &movers[i];
+    colliders[i].group = SQUARE;
+    colliders[i].mask = SQUARE | COLLIDE_FENCE;
+    colliders[i].response = COLLIDE_BOUNCE;
+    colliderAdd(&world, &colliders[i]);
+  }
+  layerInit(&layers[OBJECTS-1]);
+}
+
+void main()
+{
+  u_char step;
+  unsigned long collide, frames, pairs = 0;
+
+  configureClocks();
+  lcd_init();
+  or_sr(0x8);			/**< GIE: stopwatch overflow */
+
+  sceneInit();
+  layerGetBounds(&fieldLayer, &fieldFence);
+  layerDraw(&layers[OBJECTS-1]);
+
+  stopwatchStart();
+  for (step = 0; step < STEPS; step++) {
+    collisionStep(&world);
+    pairs += world.pairsTested;
+  }
+  stopwatchStop();
+  collide = stopwatchRead();
+
+  stopwatchStart();
+  for (step = 0; step < STEPS; step++) {
+    collisionStep(&world);
+    movLayerDraw(&movers[OBJECTS-1], &layers[OBJECTS-1]);
+  }
+  stopwatchStop();
+  frames = stopwatchRead();
+
+  drawReportLine(0, "objects", OBJECTS, REPORT_COL);
+  drawReportLine(1, "collide", collide, REPORT_COL);
+  drawReportLine(2, "frames", frames, REPORT_COL);
+  drawReportLine(3, "pairs", pairs, REPORT_COL);
+  drawReportLine(4, "all pairs", (unsigned long)STEPS * OBJECTS * (OBJECTS - 1) / 2, REPORT_COL);
+
+  for (;;)
+    or_sr(0x10);		/**< CPU OFF */
+}
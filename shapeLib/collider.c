@@ -0,0 +1,322 @@
+#include "shape.h"
+
+#define COLLIDER_DONE 1		/* moved to a contact: no more motion this step */
+#define SPANS_MAX 4		/* spans kept per row (more are merged) */
+
+void
+colliderAdd(CollisionWorld *world, Collider *c)
+{
+  c->flags = 0;
+  c->next = world->colliders;	/* sorted by the next collisionStep */
+  world->colliders = c;
+}
+
+/* true if c moves with its velocity for the rest of this step */
+static int
+moving(const Collider *c)
+{
+  return c->mover && !(c->flags & COLLIDER_DONE);
+}
+
+/* c's motion (in pixels) over the rest of this step */
+static void
+stepVelocity(const Collider *c, Vec2 *v)
+{
+  if (moving(c))
+    movLayerStep(c->mover, v);
+  else
+    *v = vec2Zero;
+}
+
+static void
+boundsAt(const Collider *c, const Vec2 *pos, Region *bounds)
+{
+  abShapeGetBounds(c->layer->abShape, pos, bounds);
+}
+
+static int
+regionsOverlap(const Region *r1, const Region *r2)
+{
+  u_char axis;
+  for (axis = 0; axis < 2; axis++)
+    if (r1->botRight.axes[axis] < r2->topLeft.axes[axis] ||
+	r2->botRight.axes[axis] < r1->topLeft.axes[axis])
+      return 0;
+  return 1;
+}
+
+/* spans of one shape on one row */
+typedef struct {
+  u_char n;
+  int colMin[SPANS_MAX], colMax[SPANS_MAX];
+} RowSpans;
+
+static void
+keepSpan(void *ctx, int colMin, int colMax)
+{
+  RowSpans *spans = ctx;
+  if (spans->n < SPANS_MAX) {
+    spans->colMin[spans->n] = colMin;
+    spans->colMax[spans->n++] = colMax;
+  } else
+    spans->colMax[SPANS_MAX-1] = colMax;
+}
+
+/* ctx is a RowSpans, emptied (n = 0) once a span overlaps one of its spans */
+static void
+overlapSpan(void *ctx, int colMin, int colMax)
+{
+  RowSpans *spans = ctx;
+  u_char i;
+  for (i = 0; i < spans->n; i++)
+    if (colMin <= spans->colMax[i] && colMax >= spans->colMin[i])
+      spans->n = 0;
+}
+
+/* true if a at posA and b at posB share a pixel; overlap is where their bounds do */
+static int
+shapesOverlap(const Collider *a, const Vec2 *posA, const Collider *b, const Vec2 *posB, 
+	      const Region *overlap)
+{
+  int row;
+  for (row = overlap->topLeft.axes[1]; row <= overlap->botRight.axes[1]; row++) {
+    RowSpans spans;
+    spans.n = 0;
+    abShapeRowSpans(a->layer->abShape, posA, row, keepSpan, &spans);
+    if (!spans.n)
+      continue;
+    abShapeRowSpans(b->layer->abShape, posB, row, overlapSpan, &spans);
+    if (!spans.n)
+      return 1;
+  }
+  return 0;
+}
+
+/* self's response to a contact, at time within the step, then moved push 
+   pixels along normal */
+static void
+respond(CollisionWorld *world, Collider *self, Collider *other, 
+	const Vec2 *normal, u_int time, int push)
+{
+  if (self->response != COLLIDE_TRIGGER && moving(self)) {
+    MovLayer *ml = self->mover;
+    Vec2 *pos = &self->layer->posNext;
+    Vec2 step;
+    u_char axis;
+    movLayerStep(ml, &step);
+    sweepMove(pos, &step, time);
+    for (axis = 0; axis < 2; axis++) {
+      int n = normal->axes[axis], v = ml->velocity.axes[axis];
+      pos->axes[axis] += n * push;
+      ml->frac[axis] = 0;
+      if ((n > 0 && v < 0) || (n < 0 && v > 0))
+	ml->velocity.axes[axis] = self->response == COLLIDE_BOUNCE ? -v : 0;
+    }
+    self->flags |= COLLIDER_DONE;
+  }
+  if (world->onCollide)
+    world->onCollide(self, other, normal);
+}
+
+/* normal (away from b) and depth of the least overlap of a's and b's bounds */
+static int
+overlapNormal(const Region *a, const Region *b, Vec2 *normal)
+{
+  int depth[2];
+  u_char axis, least;
+  for (axis = 0; axis < 2; axis++) {
+    int d1 = a->botRight.axes[axis] - b->topLeft.axes[axis];
+    int d2 = b->botRight.axes[axis] - a->topLeft.axes[axis];
+    depth[axis] = (d1 < d2 ? d1 : d2) + 1;
+    normal->axes[axis] = 0;
+  }
+  least = depth[1] < depth[0];
+  normal->axes[least] = 
+    (a->topLeft.axes[least] + a->botRight.axes[least] < 
+     b->topLeft.axes[least] + b->botRight.axes[least]) ? -1 : 1;
+  return depth[least];
+}
+
+/* first time after time (< SWEEP_ONE) that moving speed (>= 0) pixels
+   per step reaches another pixel: past SWEEP_ONE if it never does */
+static u_int
+nextPixelTime(int speed, u_int time)
+{
+  int moved;
+  u_int next;
+  if (!speed)
+    return SWEEP_ONE + 1;
+  moved = sweepScale(speed, time) + 1;
+  next = sweepFrac(moved, speed);
+  if (sweepScale(speed, next) < moved) /* round up */
+    next++;
+  return next;
+}
+
+/* From hit->time (when the bounds of a at posA and b at posB, moving 
+   by relative, first meet), step until the shapes themselves share a
+   pixel.  Each position a passes through is tested (so thin shapes are
+   not skipped over).  True (with hit's time updated, and its normal
+   too if later) if they do within the step */
+static int
+sweepShapes(const Collider *a, const Vec2 *posA, const Vec2 *relative,
+	    const Collider *b, const Vec2 *posB, Sweep *hit)
+{
+  Region boundsA, boundsB, overlap;
+  Vec2 speed = *relative;
+  u_int time = hit->time;
+  vec2Abs(&speed);
+  boundsAt(b, posB, &boundsB);
+  for (;;) {
+    Vec2 pos = *posA;
+    u_int next0, next1;
+    sweepMove(&pos, relative, time);
+    boundsAt(a, &pos, &boundsA);
+    if (regionsOverlap(&boundsA, &boundsB)) {
+      vec2Max(&overlap.topLeft, &boundsA.topLeft, &boundsB.topLeft);
+      vec2Min(&overlap.botRight, &boundsA.botRight, &boundsB.botRight);
+      if (shapesOverlap(a, &pos, b, posB, &overlap)) {
+	if (time != hit->time)	/* met past the bounds' edge */
+	  overlapNormal(&boundsA, &boundsB, &hit->normal);
+	hit->time = time;
+	return 1;
+      }
+    }
+    if (time == SWEEP_ONE)
+      return 0;
+    next0 = nextPixelTime(speed.axes[0], time);
+    next1 = nextPixelTime(speed.axes[1], time);
+    time = next0 < next1 ? next0 : next1;
+    if (time > SWEEP_ONE)
+      time = SWEEP_ONE;
+  }
+}
+
+static void
+collidePair(CollisionWorld *world, Collider *a, Collider *b)
+{
+  char aResponds = (a->mask & b->group) != 0, bResponds = (b->mask & a->group) != 0;
+  Vec2 va, vb, relative, endA, endB, normal, reverse;
+  Region startA, startB, boundsA, boundsB, overlap;
+  Sweep hit;
+  u_int time;
+  int push, pushA, pushB, swept;
+
+  if (!(aResponds || bResponds) || !(moving(a) || moving(b)))
+    return;
+  world->pairsTested++;
+
+  stepVelocity(a, &va);
+  stepVelocity(b, &vb);
+  vec2Sub(&relative, &va, &vb);
+  boundsAt(a, &a->layer->posNext, &startA);
+  boundsAt(b, &b->layer->posNext, &startB);
+  swept = sweepRegion(&startA, &relative, &startB, &hit);
+  if (!swept && regionsOverlap(&startA, &startB)) {
+    hit.time = 0;		/* the boxes overlap already: the shapes may not */
+    hit.normal = vec2Zero;
+    swept = 1;
+  }
+  if (swept)			/* shapes overlapping at the start are pushed apart below */
+    swept = sweepShapes(a, &a->layer->posNext, &relative, b, &b->layer->posNext, &hit)
+      && (hit.normal.axes[0] | hit.normal.axes[1]);
+
+  if (!swept) {
+    vec2Add(&endA, &a->layer->posNext, &va);
+    vec2Add(&endB, &b->layer->posNext, &vb);
+    boundsAt(a, &endA, &boundsA);
+    boundsAt(b, &endB, &boundsB);
+    if (!regionsOverlap(&boundsA, &boundsB))
+      return;			/* apart */
+    vec2Max(&overlap.topLeft, &boundsA.topLeft, &boundsB.topLeft);
+    vec2Min(&overlap.botRight, &boundsA.botRight, &boundsB.botRight);
+    if (!shapesOverlap(a, &endA, b, &endB, &overlap))
+      return;			/* only the bounding boxes overlap */
+  }
+
+  if (swept) {			/* back to where the shapes first meet, then apart */
+    time = hit.time;
+    normal = hit.normal;
+    pushA = pushB = 1;
+  } else {			/* already overlapping: push apart */
+    time = SWEEP_ONE;
+    push = overlapNormal(&boundsA, &boundsB, &normal);
+    pushA = pushB = push;
+    if (aResponds && bResponds && a->response != COLLIDE_TRIGGER && 
+	b->response != COLLIDE_TRIGGER && moving(a) && moving(b)) {
+      pushA = (push + 1) >> 1;	/* each goes half way */
+      pushB = push >> 1;
+    }
+  }
+  reverse.axes[0] = -normal.axes[0];
+  reverse.axes[1] = -normal.axes[1];
+  if (aResponds)
+    respond(world, a, b, &normal, time, pushA);
+  if (bResponds)
+    respond(world, b, a, &reverse, time, pushB);
+}
+
+/* insertion sort by bounds' left edge: nearly linear when nearly sorted */
+static Collider *
+sortColliders(Collider *list)
+{
+  Collider *sorted = 0, *last = 0;
+  while (list) {
+    Collider *c = list;
+    int left = c->bounds.topLeft.axes[0];
+    list = list->next;
+    c->next = 0;
+    if (!last || last->bounds.topLeft.axes[0] <= left) {
+      if (last)			/* append (the usual case) */
+	last->next = c;
+      else
+	sorted = c;
+      last = c;
+    } else {
+      Collider **p = &sorted;
+      while ((*p)->bounds.topLeft.axes[0] <= left)
+	p = &(*p)->next;
+      c->next = *p;
+      *p = c;
+    }
+  }
+  return sorted;
+}
+
+void
+collisionStep(CollisionWorld *world)
+{
+  Collider *a, *b;
+  world->pairsTested = 0;
+
+  for (a = world->colliders; a; a = a->next) { /* fence, then swept bounds */
+    Region end;
+    Sweep hit;
+    Vec2 step;
+    boundsAt(a, &a->layer->posNext, &a->bounds);
+    stepVelocity(a, &step);
+    if (a->mover && world->fence && (a->mask & COLLIDE_FENCE) &&
+	sweepWithin(&a->bounds, &step, world->fence, &hit)) {
+      respond(world, a, 0, &hit.normal, hit.time, 0);
+      boundsAt(a, &a->layer->posNext, &a->bounds);
+    }
+    if (moving(a)) {
+      vec2Add(&end.topLeft, &a->bounds.topLeft, &step);
+      vec2Add(&end.botRight, &a->bounds.botRight, &step);
+      regionUnion(&a->bounds, &a->bounds, &end);
+    }
+  }
+
+  world->colliders = sortColliders(world->colliders);
+  for (a = world->colliders; a; a = a->next) /* pairs overlapping in columns & rows */
+    for (b = a->next; b && b->bounds.topLeft.axes[0] <= a->bounds.botRight.axes[0]; b = b->next)
+      if (b->bounds.topLeft.axes[1] <= a->bounds.botRight.axes[1] &&
+	  a->bounds.topLeft.axes[1] <= b->bounds.botRight.axes[1])
+	collidePair(world, a, b);
+
+  for (a = world->colliders; a; a = a->next) {
+    if (moving(a))
+      movLayerMove(a->mover);
+    a->flags = 0;
+  }
+}
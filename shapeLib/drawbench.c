@@ -0,0 +1,116 @@
+/** \file drawbench.c
+ *  \brief Times layerDrawRegion probing layers per pixel against
+ *  composing each row in a line buffer and composing bands of palette
+ *  indices (layerDrawMode).
+ *
+ *  Redraws a REGION_SIZE square under overlapping layers REDRAWS times
+ *  each way, then times the line buffer's two phases alone: composing
+ *  rows (layerComposeRow) and sending them (lcd_writeColors).  Times
+ *  are in ms.
+ */
+#include <msp430.h>
+#include <libTimer.h>
+#include <lcdutils.h>
+#include <lcddraw.h>
+#include <lcdnum.h>
+#include "shape.h"
+
+#define REPORT_COL 90		/**< of the results' values */
+
+#define REDRAWS 20
+#define REGION_SIZE 32		/**< pixels per side (LAYER_LINE_COLS at most) */
+#define REGION_COL 40
+#define REGION_ROW 60
+
+u_int bgColor = COLOR_BLUE;
+
+AbRect rect10 = {abRectGetBounds, abRectCheck, abRectRowSpans, {10,10}};
+AbRArrow arrow20 = {abRArrowGetBounds, abRArrowCheck, abRArrowRowSpans, 20};
+char label[] = "line";
+AbText text = {abTextGetBounds, abTextCheck, abTextRowSpans, label, 4, FONT_MD};
+
+Layer textLayer = {
+  (AbShape *)&text,
+  {REGION_COL + 16, REGION_ROW + 6},
+  {0,0}, {0,0},				    /* last & next pos */
+  COLOR_WHITE,
+  0
+};
+Layer arrowLayer = {
+  (AbShape *)&arrow20,
+  {REGION_COL + 20, REGION_ROW + 20},
+  {0,0}, {0,0},
+  COLOR_YELLOW,
+  &textLayer
+};
+Layer rectLayer = {
+  (AbShape *)&rect10,
+  {REGION_COL + 10, REGION_ROW + 16},
+  {0,0}, {0,0},
+  COLOR_RED,
+  &arrowLayer
+};
+
+Region region = {{REGION_COL, REGION_ROW},
+		 {REGION_COL + REGION_SIZE - 1, REGION_ROW + REGION_SIZE - 1}};
+
+u_int lineBuffer[REGION_SIZE];
+
+/** ms to redraw the region REDRAWS times */
+u_int redraws()
+{
+  u_char i;
+  stopwatchStart();
+  for (i = 0; i < REDRAWS; i++)
+    layerDrawRegion(&rectLayer, &region);
+  stopwatchStop();
+  return stopwatchMs();
+}
+
+/** ms to compose (and, if send, send) the region's rows REDRAWS times */
+u_int phase(u_char send)
+{
+  u_char i, row;
+  stopwatchStart();
+  for (i = 0; i < REDRAWS; i++)
+    for (row = REGION_ROW; row < REGION_ROW + REGION_SIZE; row++)
+      if (send)
+	lcd_writeColors(lineBuffer, REGION_SIZE);
+      else
+	layerComposeRow(&rectLayer, row, REGION_COL,
+			REGION_COL + REGION_SIZE - 1, lineBuffer);
+  stopwatchStop();
+  return stopwatchMs();
+}
+
+void main()
+{
+  u_int pixels, lines, bands, compose, send;
+
+  configureClocks();
+  lcd_init();
+  or_sr(0x8);			/**< GIE: stopwatch overflow */
+  layerInit(&rectLayer);
+  layerDraw(&rectLayer);
+
+  layerDrawMode = LAYER_DRAW_PIXELS;
+  pixels = redraws();
+  layerDrawMode = LAYER_DRAW_LINES;
+  lines = redraws();
+  layerDrawMode = LAYER_DRAW_BANDS;
+  bands = redraws();
+  compose = phase(0);
+  lcd_setArea(REGION_COL, REGION_ROW,
+	      REGION_COL + REGION_SIZE - 1, REGION_ROW + REGION_SIZE - 1);
+  send = phase(1);
+
+  clearScreen(COLOR_BLACK);
+  drawReportLine(0, "per pixel", pixels, REPORT_COL);
+  drawReportLine(1, "line buffer", lines, REPORT_COL);
+  drawReportLine(2, " compose", compose, REPORT_COL);
+  drawReportLine(3, " send", send, REPORT_COL);
+  drawReportLine(4, "bands", bands, REPORT_COL);
+
+  for (;;)
+    or_sr(0x10);		/**< CPU OFF */
+}
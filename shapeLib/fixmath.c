@@ -0,0 +1,45 @@
+#include "fixmath.h"
+
+#define FIX_MAX 0x7fff
+
+Fix
+fixDiv(int num, int den)
+{
+  char negative = (num < 0) != (den < 0);
+  unsigned long dividend = num < 0 ? -(long)num : num;
+  unsigned long divisor = den < 0 ? -(long)den : den;
+  unsigned long rem = 0, quot = 0;
+  unsigned char bit;
+  if (!divisor)
+    return negative ? -FIX_MAX : FIX_MAX;
+  dividend <<= FIX_SHIFT;		/* < 2^24 */
+  for (bit = 0; bit < 24; bit++) { /* one quotient bit per step */
+    rem = (rem << 1) | ((dividend >> 23) & 1);
+    dividend <<= 1;
+    quot <<= 1;
+    if (rem >= divisor) {
+      rem -= divisor;
+      quot |= 1;
+    }
+  }
+  if (quot > FIX_MAX)
+    quot = FIX_MAX;
+  return negative ? -(Fix)quot : (Fix)quot;
+}
+
+Fix
+fixSin(Angle angle)
+{
+  unsigned char quarter = angle >> 6, index = angle & 63; /* 64 per quarter turn */
+  Fix sine;
+  if (quarter & 1)		/* 2nd & 4th quarters mirror 1st & 3rd */
+    index = 64 - index;
+  sine = sinTable[index];
+  return (quarter & 2) ? -sine : sine; /* 2nd half negative */
+}
+
+Fix
+fixCos(Angle angle)
+{
+  return fixSin(angle + ANGLE_TURN / 4);
+}
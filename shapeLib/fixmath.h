@@ -0,0 +1,67 @@
+/** \file fixmath.h
+ *  \brief Fixed-point arithmetic without floating point.
+ *
+ *  The MSP430 has no floating-point unit: float expressions (even a
+ *  constant such as screenWidth*.75 used at run time) link the
+ *  soft-float library and run emulated arithmetic.  Use these instead.
+ *
+ *  Fix values are 8.8 fixed point: an int holding 1/FIX_ONE units, with
+ *  range -128 .. 127.996.
+ */
+#ifndef fixmath_included
+#define fixmath_included
+
+typedef int Fix;		/**< 8.8 fixed point */
+
+#define FIX_SHIFT 8
+#define FIX_ONE (1 << FIX_SHIFT)
+#define FIX_HALF (FIX_ONE >> 1)
+
+/** Integer n as a Fix */
+#define FIX(n) ((Fix)((n) << FIX_SHIFT))
+
+/** Fix nearest the ratio num/den of integer constants, computed by the
+ *  compiler (e.g. FIX_RATIO(3,4) for .75)
+ */
+#define FIX_RATIO(num, den) ((Fix)((((long)(num) << (FIX_SHIFT + 1)) / (den) + 1) >> 1))
+
+/** x rounded to the nearest integer (halves round up) */
+static inline int fixRound(Fix x) { return (x + FIX_HALF) >> FIX_SHIFT; }
+
+/** x rounded down to an integer */
+static inline int fixFloor(Fix x) { return x >> FIX_SHIFT; }
+
+/** Product of Fixes a and b (rounded down) */
+static inline Fix fixMul(Fix a, Fix b) { return ((long)a * b) >> FIX_SHIFT; }
+
+/** Integer value scaled by Fix ratio, rounded: e.g. 
+ *  fixScale(screenWidth, FIX_RATIO(3,4)) instead of screenWidth*.75
+ */
+static inline int fixScale(int value, Fix ratio) 
+{ 
+  return ((long)value * ratio + FIX_HALF) >> FIX_SHIFT; 
+}
+
+/** num/den as a Fix (rounded toward zero), by shift and subtract.  num 
+ *  and den may both be integers or both Fixes.  Saturates (to +/-0x7fff)
+ *  when the quotient is out of range or den is 0.
+ */
+Fix fixDiv(int num, int den);
+
+/** Angles in binary units: ANGLE_TURN per full turn, so that they wrap
+ *  around in a u_char
+ */
+typedef unsigned char Angle;
+#define ANGLE_TURN 256
+#define ANGLE_DEG(deg) ((Angle)(((long)(deg) * ANGLE_TURN + 180) / 360))
+
+/** Sines of angles 0 .. ANGLE_TURN/4, generated by makeTrig */
+extern const Fix sinTable[ANGLE_TURN / 4 + 1];
+
+/** Sine of angle (by table lookup, folded into the first quarter turn) */
+Fix fixSin(Angle angle);
+
+/** Cosine of angle */
+Fix fixCos(Angle angle);
+
+#endif // included
@@ -1,16 +1,241 @@
 #include "lcdutils.h"
 #include "lcddraw.h"
+#include "lcdnum.h"
 #include "shape.h"
 
+u_char layerDrawMode = LAYER_DRAW_PIXELS;
+
+/** A line buffer holding columns colMin..colMax, being filled with color */
+typedef struct {
+  u_int *line;
+  int colMin, colMax;
+  u_int color;
+} LineFill;
+
+/** SpanFn: fill the part of a span within the line */
+static void
+lineFill(void *ctx, int colMin, int colMax)
+{
+  LineFill *f = ctx;
+  u_int *p;
+  int count;
+  if (colMin < f->colMin)
+    colMin = f->colMin;
+  if (colMax > f->colMax)
+    colMax = f->colMax;
+  p = f->line + (colMin - f->colMin);
+  for (count = colMax - colMin + 1; count > 0; count--)
+    *p++ = f->color;
+}
+
+/** The layer of layers just above below (the lowest if below is 0):
+ *  walking up this way takes no stack, unlike recursion
+ */
+static Layer *
+layerAbove(Layer *layers, const Layer *below)
+{
+  while (layers->next != below)
+    layers = layers->next;
+  return layers;
+}
+
+void
+layerComposeRow(Layer *layers, int row, int colMin, int colMax, u_int *line)
+{
+  LineFill f = {line, colMin, colMax, bgColor};
+  Layer *l = 0;
+  if (bgTileMap)
+    tileMapRow(bgTileMap, row, colMin, colMax, line);
+  else
+    lineFill(&f, colMin, colMax);
+  while (l != layers) {		/* from the lowest layer up */
+    l = layerAbove(layers, l);
+    f.color = l->color;
+    abShapeRowSpans(l->abShape, &l->pos, row, lineFill, &f);
+  }
+}
+
+/** Draw r (within the screen) through line, a buffer of cols colors */
+static void
+drawRegionLines(Layer *layers, const Region *r, u_int *line, u_int cols)
+{
+  int row, colMin, colMax;
+  for (colMin = r->topLeft.axes[0]; colMin <= r->botRight.axes[0]; colMin = colMax + 1) {
+    colMax = colMin + cols - 1;
+    if (colMax > r->botRight.axes[0])
+      colMax = r->botRight.axes[0];
+    lcd_setArea(colMin, r->topLeft.axes[1], colMax, r->botRight.axes[1]);
+    for (row = r->topLeft.axes[1]; row <= r->botRight.axes[1]; row++) {
+      layerComposeRow(layers, row, colMin, colMax, line); /* compute... */
+      lcd_writeColors(line, colMax - colMin + 1);	  /* ...then send */
+    }
+  }
+}
+
+#if BAND_BPP != 2 && BAND_BPP != 4
+#error "BAND_BPP must be 2 or 4"
+#endif
+
+#define BAND_PIXELS (8 / BAND_BPP)	/* per byte */
+#define BAND_SHIFT (BAND_BPP == 2 ? 2 : 1) /* log2(BAND_PIXELS) */
+#define BAND_COLORS (1 << BAND_BPP)
+#define BAND_BYTES (BAND_ROWS * screenWidth / BAND_PIXELS)
+
+/** A band being composed */
+typedef struct {
+  const Region *r;		/* the band's rows & columns */
+  u_char *row;			/* (of the band) being filled */
+  u_char stride;		/* bytes per row */
+  u_char colors;		/* in palette */
+  u_char fill;			/* palette index, repeated in each pixel of a byte */
+  u_int palette[BAND_COLORS];
+} BandFill;
+
+/** SpanFn: set the band row's pixels within the span to fill */
+static void
+bandFill(void *ctx, int colMin, int colMax)
+{
+  BandFill *f = ctx;
+  u_char *p, *last, maskFirst, maskLast;
+  if (colMin < f->r->topLeft.axes[0])
+    colMin = f->r->topLeft.axes[0];
+  if (colMax > f->r->botRight.axes[0])
+    colMax = f->r->botRight.axes[0];
+  if (colMin > colMax)
+    return;
+  colMin -= f->r->topLeft.axes[0];
+  colMax -= f->r->topLeft.axes[0];
+  p = f->row + (colMin >> BAND_SHIFT);
+  last = f->row + (colMax >> BAND_SHIFT);
+  maskFirst = 0xff >> ((colMin & (BAND_PIXELS-1)) * BAND_BPP);
+  maskLast = 0xff << ((BAND_PIXELS-1 - (colMax & (BAND_PIXELS-1))) * BAND_BPP);
+  if (p == last) {
+    maskFirst &= maskLast;
+    *p = (*p & ~maskFirst) | (f->fill & maskFirst);
+    return;
+  }
+  *p = (*p & ~maskFirst) | (f->fill & maskFirst);
+  while (++p < last)		/* whole bytes */
+    *p = f->fill;
+  *p = (*p & ~maskLast) | (f->fill & maskLast);
+}
+
+/** Does l have pixels within r?  (by its bounds) */
+static int
+layerMeets(const Layer *l, const Region *r)
+{
+  Region bounds;
+  abShapeGetBounds(l->abShape, &l->pos, &bounds);
+  return bounds.topLeft.axes[0] <= r->botRight.axes[0] 
+    && bounds.botRight.axes[0] >= r->topLeft.axes[0]
+    && bounds.topLeft.axes[1] <= r->botRight.axes[1] 
+    && bounds.botRight.axes[1] >= r->topLeft.axes[1];
+}
+
+/** Palette index of color, adding it if new: BAND_COLORS if full */
+static u_char
+bandColor(BandFill *f, u_int color)
+{
+  u_char i;
+  for (i = 0; i < f->colors; i++)
+    if (f->palette[i] == color)
+      return i;
+  if (f->colors < BAND_COLORS)
+    f->palette[f->colors++] = color;
+  return i;
+}
+
+/** Fill the spans of the layers within the band, from the lowest up 
+ *  (their colors are already in the palette)
+ */
+static void
+bandLayers(Layer *layers, BandFill *f, u_char *band)
+{
+  Layer *l = 0;
+  u_char shift;
+  int row;
+  while (l != layers) {
+    l = layerAbove(layers, l);
+    if (!layerMeets(l, f->r))
+      continue;
+    f->fill = bandColor(f, l->color);
+    for (shift = BAND_BPP; shift < 8; shift <<= 1) /* in each pixel of a byte */
+      f->fill |= f->fill << shift;
+    f->row = band;
+    for (row = f->r->topLeft.axes[1]; row <= f->r->botRight.axes[1]; row++) {
+      abShapeRowSpans(l->abShape, &l->pos, row, bandFill, f);
+      f->row += f->stride;
+    }
+  }
+}
+
+/** Draw r (within the screen) a band of rows at a time, through buffer
+ *  (BAND_BYTES): bands whose colors do not fit are drawn through it as
+ *  lines
+ */
+static void
+drawRegionBands(Layer *layers, const Region *r, u_int *buffer)
+{
+  u_char *band = (u_char *)buffer, *p, *end;
+  BandFill f;
+  Region b = *r;
+  Layer *l;
+  u_int width = r->botRight.axes[0] - r->topLeft.axes[0] + 1, rows;
+  f.r = &b;
+  f.stride = (width + BAND_PIXELS - 1) >> BAND_SHIFT;
+  rows = BAND_BYTES / f.stride;
+  for (; b.topLeft.axes[1] <= r->botRight.axes[1]; b.topLeft.axes[1] += rows) {
+    b.botRight.axes[1] = b.topLeft.axes[1] + rows - 1;
+    if (b.botRight.axes[1] > r->botRight.axes[1])
+      b.botRight.axes[1] = r->botRight.axes[1];
+    f.palette[0] = bgColor;	/* index 0 */
+    f.colors = 1;
+    for (l = layers; l; l = l->next)
+      if (layerMeets(l, &b) && bandColor(&f, l->color) == BAND_COLORS)
+	break;
+    if (l || bgTileMap) {	/* its colors do not fit the palette */
+      drawRegionLines(layers, &b, buffer, BAND_BYTES / 2);
+      continue;
+    }
+    end = band + f.stride * (b.botRight.axes[1] - b.topLeft.axes[1] + 1);
+    for (p = band; p < end; p++)
+      *p = 0;			/* background */
+    bandLayers(layers, &f, band); /* compute... */
+    lcd_setArea(b.topLeft.axes[0], b.topLeft.axes[1], b.botRight.axes[0], b.botRight.axes[1]);
+    for (p = band; p < end; p += f.stride) /* ...then send */
+      lcd_writeIndexed(p, width, BAND_BPP, f.palette);
+  }
+}
+
+/* words of the one buffer drawing lines or bands uses */
+#define BUFFER_WORDS (LAYER_LINE_COLS > BAND_BYTES / 2 ? LAYER_LINE_COLS : BAND_BYTES / 2)
+
+/** Draw r (within the screen) as layerDrawMode (LINES or BANDS) says */
+static void
+drawRegionBuffered(Layer *layers, const Region *r)
+{
+  u_int buffer[BUFFER_WORDS];
+  if (layerDrawMode == LAYER_DRAW_BANDS)
+    drawRegionBands(layers, r, buffer);
+  else
+    drawRegionLines(layers, r, buffer, LAYER_LINE_COLS);
+}
+
 void
 layerDraw(Layer *layers)
 {
   int row, col;
+  if (layerDrawMode != LAYER_DRAW_PIXELS) {
+    Region screen = {{0, 0}, {screenWidth-1, screenHeight-1}};
+    layerDrawRegion(layers, &screen);
+    return;
+  }
   for (row = 0; row < screenHeight; row++) {
+    const u_char *bgRow = bgTileMap ? tileMapRowTiles(bgTileMap, row) : 0;
     lcd_setArea(0, row, screenWidth-1, row);
     for (col = 0; col < screenWidth; col++) {
       Vec2 pixelPos = {col, row};
-      u_int color = bgColor;
+      u_int color;
       Layer *probeLayer;
       for (probeLayer = layers; probeLayer; probeLayer = probeLayer->next) {
 	if (abShapeCheck(probeLayer->abShape, &probeLayer->pos, &pixelPos)) {
@@ -18,12 +243,101 @@ layerDraw(Layer *layers)
 	  break; 
 	} /* if check */
       } // for checking all layers at col, row
+      if (!probeLayer)		/* background */
+	color = bgTileMap ? tileMapRowColor(bgTileMap, bgRow, col, row) : bgColor;
       lcd_writeColor(color); 
     } // for col
   } // for row
 } 
 
+void
+layerDrawRegion(Layer *layers, const Region *region)
+{
+  int row, col;
+  Region r = *region;		/* clip to screen */
+  vec2Max(&r.topLeft, &r.topLeft, &vec2Zero);
+  if (r.botRight.axes[0] > screenWidth - 1)
+    r.botRight.axes[0] = screenWidth - 1;
+  if (r.botRight.axes[1] > screenHeight - 1)
+    r.botRight.axes[1] = screenHeight - 1;
+  if (r.topLeft.axes[0] > r.botRight.axes[0] || r.topLeft.axes[1] > r.botRight.axes[1])
+    return;
+  if (layerDrawMode != LAYER_DRAW_PIXELS) {
+    drawRegionBuffered(layers, &r);
+    return;
+  }
+  lcd_setArea(r.topLeft.axes[0], r.topLeft.axes[1], 
+	      r.botRight.axes[0], r.botRight.axes[1]);
+  for (row = r.topLeft.axes[1]; row <= r.botRight.axes[1]; row++) {
+    const u_char *bgRow = bgTileMap ? tileMapRowTiles(bgTileMap, row) : 0;
+    for (col = r.topLeft.axes[0]; col <= r.botRight.axes[0]; col++) {
+      Vec2 pixelPos = {col, row};
+      u_int color;
+      Layer *probeLayer;
+      for (probeLayer = layers; probeLayer; probeLayer = probeLayer->next) {
+	if (abShapeCheck(probeLayer->abShape, &probeLayer->pos, &pixelPos)) {
+	  color = probeLayer->color;
+	  break; 
+	} /* if check */
+      } // for checking all layers at col, row
+      if (!probeLayer)		/* background */
+	color = bgTileMap ? tileMapRowColor(bgTileMap, bgRow, col, row) : bgColor;
+      lcd_writeColor(color); 
+    } // for col
+  } // for row
+}
+
+static Layer *drawLayers;	/* being drawn by layerDrawStep */
+static int drawRow = screenHeight; /* next row to draw */
+
+void
+layerDrawBegin(Layer *layers)
+{
+  drawLayers = layers;
+  drawRow = 0;
+}
+
+int
+layerDrawStep(u_char rows)
+{
+  Region band;
+  if (drawRow >= screenHeight)
+    return 0;
+  band.topLeft.axes[0] = 0;
+  band.topLeft.axes[1] = drawRow;
+  band.botRight.axes[0] = screenWidth - 1;
+  band.botRight.axes[1] = drawRow + rows - 1;
+  layerDrawRegion(drawLayers, &band); /* (clipped to the screen) */
+  drawRow += rows;
+  return drawRow < screenHeight;
+}
+
+void
+layerTextSetChar(Layer *textLayer, Layer *layers, u_char index, char c)
+{
+  AbText *text = (AbText *)textLayer->abShape;
+  u_char font = text->font;
+  Region cell;
+  if (index >= text->len || text->text[index] == c)
+    return;
+  text->text[index] = c;
+  abTextGetBounds(text, &textLayer->pos, &cell);
+  while (index--)		/* step to the character's cell */
+    cell.topLeft.axes[0] += fontAdvance[font];
+  cell.botRight.axes[0] = cell.topLeft.axes[0] + fontWidth[font] - 1;
+  layerDrawRegion(layers, &cell);
+}
 
+void
+layerTextSetNumber(Layer *textLayer, Layer *layers, int value, u_char format)
+{
+  AbText *text = (AbText *)textLayer->abShape;
+  NumChars chars;
+  u_char index;
+  numCharsInit(&chars, value, format, text->len);
+  for (index = 0; index < text->len; index++)
+    layerTextSetChar(textLayer, layers, index, numCharsAt(&chars, index));
+}
 
 void
 layerGetBounds(const Layer *l, Region *bounds)
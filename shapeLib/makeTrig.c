@@ -0,0 +1,26 @@
+// Generate sintable.c: sines of the first quarter turn as Fixes (8.8),
+// so that fixSin and fixCos need no trigonometry or division at run time
+#include <stdio.h>
+#include <math.h>
+#include <assert.h>
+#include "fixmath.h"
+
+#define QUARTER (ANGLE_TURN / 4)
+
+int main()
+{
+  int angle;
+  FILE *fp = fopen("sintable.c", "w");
+  assert(fp);
+  fprintf(fp, "// Automatically generated by makeTrig.\n");
+  fprintf(fp, "#include \"fixmath.h\"\n\n");
+  fprintf(fp, "const Fix sinTable[%d] = {\n", QUARTER + 1);
+  for (angle = 0; angle <= QUARTER; angle++) {
+    double radians = angle * 2 * M_PI / ANGLE_TURN;
+    fprintf(fp, "    %d, // angle %d/%d\n", 
+	    (int)floor(sin(radians) * FIX_ONE + 0.5), angle, ANGLE_TURN);
+  }
+  fprintf(fp, "};\n");
+  fclose(fp);
+  return 0;
+}
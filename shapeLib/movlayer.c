@@ -0,0 +1,45 @@
+#include <libTimer.h>
+#include "shape.h"
+
+void
+movLayerStep(const MovLayer *ml, Vec2 *step)
+{
+  u_char axis;
+  for (axis = 0; axis < 2; axis++)
+    step->axes[axis] = fixRound(ml->frac[axis] + ml->velocity.axes[axis]);
+}
+
+void
+movLayerMove(MovLayer *ml)
+{
+  u_char axis;
+  for (axis = 0; axis < 2; axis++) {
+    int offset = ml->frac[axis] + ml->velocity.axes[axis];
+    int pixels = fixRound(offset);
+    ml->layer->posNext.axes[axis] += pixels;
+    ml->frac[axis] = offset - (pixels << MOV_SHIFT);
+  }
+}
+
+void
+movLayerDraw(MovLayer *movLayers, Layer *layers)
+{
+  MovLayer *movLayer;
+
+  and_sr(~8);			/**< disable interrupts (GIE off) */
+  for (movLayer = movLayers; movLayer; movLayer = movLayer->next) { /* for each moving layer */
+    Layer *l = movLayer->layer;
+    l->posLast = l->pos;
+    l->pos = l->posNext;
+  }
+  or_sr(8);			/**< enable interrupts (GIE on) */
+
+  for (movLayer = movLayers; movLayer; movLayer = movLayer->next) { /* for each moving layer */
+    Layer *l = movLayer->layer;
+    Region bounds;
+    if (l->pos.axes[0] == l->posLast.axes[0] && l->pos.axes[1] == l->posLast.axes[1])
+      continue;			/* still on the same pixels */
+    layerGetBounds(l, &bounds);
+    layerDrawRegion(layers, &bounds);
+  }
+}
@@ -0,0 +1,154 @@
+#include "shape.h"
+
+/* advance edge e by a row */
+static void
+edgeStep(PolyEdge *e)
+{
+  u_int err = e->err + e->r;
+  e->x += e->q;
+  if (err >= e->dy) {
+    e->x++;
+    err -= e->dy;
+  }
+  e->err = err;
+}
+
+/* start walking the edge on the left (or right) side that spans row.
+   In clockwise order, right edges head down and left edges head up. */
+static void
+edgeFind(const signed char (*vertices)[2], u_char count, u_char right, int row, PolyEdge *e)
+{
+  u_char i, j;
+  const signed char *top, *bot;
+  int dCol, rows;
+  for (i = 0; i < count; i++) {
+    j = (i + 1 == count) ? 0 : i + 1;
+    top = right ? vertices[i] : vertices[j];
+    bot = right ? vertices[j] : vertices[i];
+    if (top[1] < bot[1] && top[1] <= row && row <= bot[1])
+      break;
+  }
+  if (i == count) {		/* row is above or below the polygon */
+    e->edge = -1;
+    return;
+  }
+  e->edge = i;
+  e->bottom = bot[1];
+  e->dy = bot[1] - top[1];
+  dCol = bot[0] - top[0];	/* columns per row: q + r/dy (floor) */
+  e->q = 0;
+  while (dCol < 0) {
+    dCol += e->dy;
+    e->q--;
+  }
+  while (dCol >= e->dy) {
+    dCol -= e->dy;
+    e->q++;
+  }
+  e->r = dCol;
+  e->x = top[0];
+  e->err = 0;
+  for (rows = row - top[1]; rows; rows--)
+    edgeStep(e);
+}
+
+/* bring walk to row, stepping its edges if it was at the row above */
+static void
+polyWalk(const void *shape, const signed char (*vertices)[2], u_char count, PolyWalk *walk, const Vec2 *centerPos, int row)
+{
+  u_char side, fresh = 1;
+  PolyEdge *left = &walk->side[0], *right = &walk->side[1];
+  row -= centerPos->axes[1];
+  if (walk->shape == shape && walk->center.axes[0] == centerPos->axes[0]
+      && walk->center.axes[1] == centerPos->axes[1]) {
+    if (row == walk->row)
+      return;
+    fresh = row != walk->row + 1;
+  }
+  walk->shape = shape;
+  walk->center = *centerPos;
+  walk->row = row;
+  for (side = 0; side < 2; side++) {
+    PolyEdge *e = &walk->side[side];
+    if (fresh || e->edge < 0 || row > e->bottom)
+      edgeFind(vertices, count, side, row, e);
+    else
+      edgeStep(e);
+  }
+  if (left->edge < 0 || right->edge < 0) {
+    walk->colMin = 1;
+    walk->colMax = 0;
+  } else {			/* pixel centers within both edges */
+    walk->colMin = left->x + (left->err != 0);
+    walk->colMax = right->x;
+  }
+}
+
+static void
+polyBounds(const signed char (*vertices)[2], u_char count, const Vec2 *centerPos, Region *bounds)
+{
+  u_char i, axis;
+  for (axis = 0; axis < 2; axis++) {
+    int min = vertices[0][axis], max = min;
+    for (i = 1; i < count; i++) {
+      int v = vertices[i][axis];
+      if (v < min) min = v;
+      if (v > max) max = v;
+    }
+    bounds->topLeft.axes[axis] = centerPos->axes[axis] + min;
+    bounds->botRight.axes[axis] = centerPos->axes[axis] + max;
+  }
+  regionClipScreen(bounds);
+}
+
+static int
+polyCheck(const void *shape, const signed char (*vertices)[2], u_char count, PolyWalk *walk, const Vec2 *centerPos, const Vec2 *pixel)
+{
+  int col = pixel->axes[0] - centerPos->axes[0];
+  polyWalk(shape, vertices, count, walk, centerPos, pixel->axes[1]);
+  return walk->colMin <= col && col <= walk->colMax;
+}
+
+static void
+polyRowSpans(const void *shape, const signed char (*vertices)[2], u_char count, PolyWalk *walk, const Vec2 *centerPos, int row, SpanFn emit, void *ctx)
+{
+  polyWalk(shape, vertices, count, walk, centerPos, row);
+  if (walk->colMin <= walk->colMax)
+    (*emit)(ctx, centerPos->axes[0] + walk->colMin, centerPos->axes[0] + walk->colMax);
+}
+
+void
+abConvexPolyGetBounds(const AbConvexPoly *poly, const Vec2 *centerPos, Region *bounds)
+{
+  polyBounds(poly->vertices, poly->count, centerPos, bounds);
+}
+
+int
+abConvexPolyCheck(const AbConvexPoly *poly, const Vec2 *centerPos, const Vec2 *pixel)
+{
+  return polyCheck(poly, poly->vertices, poly->count, poly->walk, centerPos, pixel);
+}
+
+void
+abConvexPolyRowSpans(const AbConvexPoly *poly, const Vec2 *centerPos, int row, SpanFn emit, void *ctx)
+{
+  polyRowSpans(poly, poly->vertices, poly->count, poly->walk, centerPos, row, emit, ctx);
+}
+
+void
+abTriangleGetBounds(const AbTriangle *tri, const Vec2 *centerPos, Region *bounds)
+{
+  polyBounds(tri->vertices, 3, centerPos, bounds);
+}
+
+int
+abTriangleCheck(const AbTriangle *tri, const Vec2 *centerPos, const Vec2 *pixel)
+{
+  return polyCheck(tri, tri->vertices, 3, tri->walk, centerPos, pixel);
+}
+
+void
+abTriangleRowSpans(const AbTriangle *tri, const Vec2 *centerPos, int row, SpanFn emit, void *ctx)
+{
+  polyRowSpans(tri, tri->vertices, 3, tri->walk, centerPos, row, emit, ctx);
+}
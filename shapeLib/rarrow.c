@@ -37,4 +37,20 @@ abRArrowGetBounds(const AbRArrow *arrow, const Vec2 *centerPos, Region *bounds)
   bounds->botRight.axes[1] = centerPos->axes[1] + halfSize;
 }
 
-
+/** RowSpans function required by AbShape
+ *  abRArrowRowSpans emits the single span of the arrow on row: 
+ *  the tip alone, or the tip and stem when row is within the stem.
+ */
+void
+abRArrowRowSpans(const AbRArrow *arrow, const Vec2 *centerPos, int row, SpanFn emit, void *ctx)
+{
+  int size = arrow->size;
+  int halfSize = size/2, quarterSize = halfSize/2;
+  int tipCol = centerPos->axes[0];
+  row -= centerPos->axes[1];
+  row = (row >= 0) ? row : -row; /* row = |row| */
+  if (row <= quarterSize)	/* tip and stem */
+    (*emit)(ctx, tipCol - size, tipCol - row);
+  else if (row <= halfSize)	/* tip only */
+    (*emit)(ctx, tipCol - halfSize, tipCol - row);
+}
@@ -22,6 +22,16 @@ void abRectGetBounds(const AbRect *rect, const Vec2 *centerPos, Region *bounds)
   vec2Add(&bounds->botRight, centerPos, &rect->halfSize);
 }
 
+// a rect's row is a single span
+void
+abRectRowSpans(const AbRect *rect, const Vec2 *centerPos, int row, SpanFn emit, void *ctx)
+{
+  int rowOffset = row - centerPos->axes[1];
+  int halfWidth = rect->halfSize.axes[0];
+  if (rowOffset >= -rect->halfSize.axes[1] && rowOffset <= rect->halfSize.axes[1])
+    (*emit)(ctx, centerPos->axes[0] - halfWidth, centerPos->axes[0] + halfWidth);
+}
+
 
 
 // true if pixel is in rect centerPosed at rectPos
@@ -49,5 +59,19 @@ void abRectOutlineGetBounds(const AbRectOutline *rect, const Vec2 *centerPos, Re
   vec2Add(&bounds->botRight, centerPos, &rect->halfSize);
 }
 
-
-
+// top & bottom rows are a single span, others are the two sides
+void
+abRectOutlineRowSpans(const AbRectOutline *rect, const Vec2 *centerPos, int row, SpanFn emit, void *ctx)
+{
+  Region bounds;
+  abRectOutlineGetBounds(rect, centerPos, &bounds);
+  int left = bounds.topLeft.axes[0], right = bounds.botRight.axes[0];
+  if (row < bounds.topLeft.axes[1] || row > bounds.botRight.axes[1])
+    return;
+  if (row == bounds.topLeft.axes[1] || row == bounds.botRight.axes[1] || left == right) {
+    (*emit)(ctx, left, right);
+  } else {
+    (*emit)(ctx, left, left);
+    (*emit)(ctx, right, right);
+  }
+}
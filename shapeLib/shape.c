@@ -22,3 +22,33 @@ abShapeCheck(const AbShape *s, const Vec2 *centerPos, const Vec2 *pixelLoc)
   return (*s->check)(s, centerPos, pixelLoc);
 }
 
+void
+abShapeRowSpans(const AbShape *s, const Vec2 *centerPos, int row, SpanFn emit, void *ctx)
+{
+  (*s->rowSpans)(s, centerPos, row, emit, ctx);
+}
+
+void
+abShapeCheckSpans(const AbShape *s, const Vec2 *centerPos, int row, SpanFn emit, void *ctx)
+{
+  Region bounds;
+  Vec2 pixel;
+  int colMin, inRun = 0;
+  abShapeGetBounds(s, centerPos, &bounds);
+  if (row < bounds.topLeft.axes[1] || row > bounds.botRight.axes[1])
+    return;
+  pixel.axes[1] = row;
+  for (pixel.axes[0] = bounds.topLeft.axes[0]; 
+       pixel.axes[0] <= bounds.botRight.axes[0]; pixel.axes[0]++) {
+    if (abShapeCheck(s, centerPos, &pixel)) {
+      if (!inRun)
+	colMin = pixel.axes[0];
+      inRun = 1;
+    } else if (inRun) {
+      (*emit)(ctx, colMin, pixel.axes[0] - 1);
+      inRun = 0;
+    }
+  }
+  if (inRun)
+    (*emit)(ctx, colMin, bounds.botRight.axes[0]);
+}
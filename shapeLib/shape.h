@@ -6,6 +6,7 @@
 #define shape_included
 
 #include "lcdutils.h"
+#include "fixmath.h"
 
 /** Vec2 contain a position or vector
  *
@@ -42,6 +43,11 @@ void vec2Add(Vec2 *result, const Vec2 *a1, const Vec2 *a2);
  */ 
 void vec2Sub(Vec2 *result, const Vec2 *a1, const Vec2 *a2);
 
+/** Vector of length (a Fix) pointing at angle: 0 is toward increasing
+ *  col, ANGLE_DEG(90) toward increasing row.  Components are Fixes.
+ */
+void vec2Direction(Vec2 *result, Angle angle, Fix length);
+
 /** Absolute value in each direction
  *  
  *  \param vec (in and out) The vector
@@ -69,20 +75,31 @@ void regionClipScreen(Region *region);
  */
 void shapeInit();
 
+/** Receives one horizontal run of pixels on a row: 
+ *  columns colMin through colMax (inclusive, not clipped to the screen).
+ *  ctx is passed through unchanged from the rowSpans caller.
+ */
+typedef void (*SpanFn)(void *ctx, int colMin, int colMax);
+
 /** Effectively a base class for Abstract Shapes
  *  
  *  Abstract Shapes have a shape but no position or color.
- *  The first two fields MUST BE pointers to
+ *  The first three fields MUST BE pointers to
  *
  *  getBounds: A function that computes the bounding box for the AbShape
  *  when rendered at coordinate centerPos
  * 
  *  check: A function that determines if the AbShape contains pixelLoc when 
  *  rendered at centerPos
+ *
+ *  rowSpans: A function that calls emit for each run of pixels the AbShape
+ *  contains on a row (left to right) when rendered at centerPos.  
+ *  Shapes that only implement check can use abShapeCheckSpans.
  */
 typedef struct AbShape_s {		/* base type for all abstrct shapes */
   void (*getBounds)(const struct AbShape_s *shape, const Vec2 *centerPos, Region *bounds);
   int (*check)(const struct AbShape_s *shape, const Vec2 *centerPos, const Vec2 *pixelLoc);
+  void (*rowSpans)(const struct AbShape_s *shape, const Vec2 *centerPos, int row, SpanFn emit, void *ctx);
 } AbShape;
 
 /** Computes bounding box of abShape in screen coordinates 
@@ -102,6 +119,21 @@ void abShapeGetBounds(const AbShape *s, const Vec2 *centerPos, Region *bounds);
  */
 int abShapeCheck(const AbShape *shape, const Vec2 *centerPos, const Vec2 *pixelLoc);
 
+/** Emit the runs of pixels within the abShape on row
+ *
+ *  \param shape (in) The abstract shape
+ *  \param centerPos (in) The Vec2 specifying the center position of the shape
+ *  \param row (in) The screen row
+ *  \param emit (in) Called for each run, left to right
+ *  \param ctx (in) Passed to emit
+ */
+void abShapeRowSpans(const AbShape *shape, const Vec2 *centerPos, int row, SpanFn emit, void *ctx);
+
+/** A rowSpans function for any AbShape: finds runs by calling check 
+ *  for each pixel of the row within the shape's bounds.
+ */
+void abShapeCheckSpans(const AbShape *shape, const Vec2 *centerPos, int row, SpanFn emit, void *ctx);
+
 /** An AbShape Right Arrow with filled tip
  *
  *  size: width of the arrow.  Tip is a triangle with width=1/2 size.
@@ -110,6 +142,7 @@ int abShapeCheck(const AbShape *shape, const Vec2 *centerPos, const Vec2 *pixelL
 typedef struct AbRArrow_s {
   void (*getBounds)(const struct AbRArrow_s *shape, const Vec2 *centerPos, Region *bounds);
   int (*check)(const struct AbRArrow_s *shape, const Vec2 *centerPos, const Vec2 *pixelLoc);
+  void (*rowSpans)(const struct AbRArrow_s *shape, const Vec2 *centerPos, int row, SpanFn emit, void *ctx);
   int size;
 } AbRArrow;
 
@@ -121,6 +154,10 @@ void abRArrowGetBounds(const AbRArrow *arrow, const Vec2 *centerPos, Region *bou
  */
 int abRArrowCheck(const AbRArrow *arrow, const Vec2 *centerPos, const Vec2 *pixel);
 
+/** As required by AbShape
+ */
+void abRArrowRowSpans(const AbRArrow *arrow, const Vec2 *centerPos, int row, SpanFn emit, void *ctx);
+
 /** AbShape rectangle
  *
  *  Vector halfSize must be to first quadrant (both axes non-negative).  
@@ -129,6 +166,7 @@ int abRArrowCheck(const AbRArrow *arrow, const Vec2 *centerPos, const Vec2 *pixe
 typedef struct AbRect_s {
   void (*getBounds)(const struct AbRect_s *rect, const Vec2 *centerPos, Region *bounds);
   int (*check)(const struct AbRect_s *shape, const Vec2 *centerPos, const Vec2 *pixel);
+  void (*rowSpans)(const struct AbRect_s *shape, const Vec2 *centerPos, int row, SpanFn emit, void *ctx);
   const Vec2 halfSize;	
 } AbRect;
 
@@ -140,6 +178,10 @@ void abRectGetBounds(const AbRect *rect, const Vec2 *centerPos, Region *bounds);
  */
 int abRectCheck(const AbRect *rect, const Vec2 *centerPos, const Vec2 *pixel);
 
+/** As required by AbShape
+ */
+void abRectRowSpans(const AbRect *rect, const Vec2 *centerPos, int row, SpanFn emit, void *ctx);
+
 typedef AbRect AbRectOutline;	/* same as AbRect */
 
 /** As required by AbShape
@@ -150,6 +192,261 @@ void abRectOutlineGetBounds(const AbRect *rect, const Vec2 *centerPos, Region *b
  */
 int abRectOutlineCheck(const AbRect *rect, const Vec2 *centerPos, const Vec2 *pixel);
 
+/** As required by AbShape
+ */
+void abRectOutlineRowSpans(const AbRect *rect, const Vec2 *centerPos, int row, SpanFn emit, void *ctx);
+
+/** AbShape text: a line of characters in one of lcdLib's fonts
+ *
+ *  text must point to (writable) storage for len characters; unused
+ *  positions should hold spaces.  Only the glyphs' foreground pixels
+ *  are within the shape, so lower layers show between strokes.
+ *  The line is centered at centerPos.
+ */
+typedef struct AbText_s {
+  void (*getBounds)(const struct AbText_s *text, const Vec2 *centerPos, Region *bounds);
+  int (*check)(const struct AbText_s *text, const Vec2 *centerPos, const Vec2 *pixel);
+  void (*rowSpans)(const struct AbText_s *text, const Vec2 *centerPos, int row, SpanFn emit, void *ctx);
+  char *text;
+  const u_char len;		/**< characters */
+  const u_char font;		/**< FONT_SM, FONT_MD or FONT_LG (lcddraw.h) */
+} AbText;
+
+/** As required by AbShape
+ */
+void abTextGetBounds(const AbText *text, const Vec2 *centerPos, Region *bounds);
+
+/** As required by AbShape
+ */
+int abTextCheck(const AbText *text, const Vec2 *centerPos, const Vec2 *pixel);
+
+/** As required by AbShape
+ */
+void abTextRowSpans(const AbText *text, const Vec2 *centerPos, int row, SpanFn emit, void *ctx);
+
+/** AbShape span table: a shape stored as its runs of pixels, row by row
+ *  (typically generated offline, e.g. by spanLib's makeShapes).
+ *
+ *  The table covers width x height pixels; table position 
+ *  (originCol, originRow) is rendered at centerPos.  spans holds 
+ *  (colMin, colMax) pairs, inclusive and relative to the table's left 
+ *  edge.  If rowIndex is 0, each row has exactly one pair 
+ *  (colMin > colMax for an empty row).  Otherwise row r's pairs are 
+ *  spans[2*rowIndex[r]] up to spans[2*rowIndex[r+1]].
+ *
+ *  A folded table is symmetric top to bottom and stores only its first
+ *  (height+1)/2 rows; row r of the lower half is stored as row 
+ *  height-1-r.
+ */
+typedef struct AbSpanTable_s {
+  void (*getBounds)(const struct AbSpanTable_s *table, const Vec2 *centerPos, Region *bounds);
+  int (*check)(const struct AbSpanTable_s *table, const Vec2 *centerPos, const Vec2 *pixel);
+  void (*rowSpans)(const struct AbSpanTable_s *table, const Vec2 *centerPos, int row, SpanFn emit, void *ctx);
+  const u_int *rowIndex;	/**< one more entry than rows stored, or 0 */
+  const u_char *spans;
+  const u_char width, height;
+  const u_char originCol, originRow;
+  const u_char folded;		/**< true if the lower half mirrors the upper */
+} AbSpanTable;
+
+/** As required by AbShape
+ */
+void abSpanTableGetBounds(const AbSpanTable *table, const Vec2 *centerPos, Region *bounds);
+
+/** As required by AbShape
+ */
+int abSpanTableCheck(const AbSpanTable *table, const Vec2 *centerPos, const Vec2 *pixel);
+
+/** As required by AbShape
+ */
+void abSpanTableRowSpans(const AbSpanTable *table, const Vec2 *centerPos, int row, SpanFn emit, void *ctx);
+
+/** AbShape bitmap: a 1-bit mask in flash
+ *
+ *  bits holds height rows of (width+7)/8 bytes; the leftmost pixel of 
+ *  each byte is its bit 7, and bits past width are clear.  Mask 
+ *  position (originCol, originRow) is rendered at centerPos.  The mask
+ *  may also be stored as runs (typically generated by spanLib's 
+ *  makeShapes), laid out as an indexed AbSpanTable's: row r's 
+ *  (colMin, colMax) pairs are spans[2*rowIndex[r]] up to 
+ *  spans[2*rowIndex[r+1]].  rowSpans uses the runs if rowIndex is not 0.
+ */
+typedef struct AbBitmap_s {
+  void (*getBounds)(const struct AbBitmap_s *bitmap, const Vec2 *centerPos, Region *bounds);
+  int (*check)(const struct AbBitmap_s *bitmap, const Vec2 *centerPos, const Vec2 *pixel);
+  void (*rowSpans)(const struct AbBitmap_s *bitmap, const Vec2 *centerPos, int row, SpanFn emit, void *ctx);
+  const u_char *bits;
+  const u_int *rowIndex;	/**< height+1 entries, or 0 */
+  const u_char *spans;
+  const u_char width, height;
+  const u_char originCol, originRow;
+} AbBitmap;
+
+/** As required by AbShape
+ */
+void abBitmapGetBounds(const AbBitmap *bitmap, const Vec2 *centerPos, Region *bounds);
+
+/** As required by AbShape
+ */
+int abBitmapCheck(const AbBitmap *bitmap, const Vec2 *centerPos, const Vec2 *pixel);
+
+/** As required by AbShape
+ */
+void abBitmapRowSpans(const AbBitmap *bitmap, const Vec2 *centerPos, int row, SpanFn emit, void *ctx);
+
+/** One side (left or right) of a convex polygon, walked a row at a time.
+ *  Its column is x + err/dy, and advances q + r/dy columns per row.
+ */
+typedef struct {
+  signed char edge;		/**< first vertex of the edge, -1 if none */
+  signed char bottom;		/**< last row of the edge */
+  u_char dy, err, r;
+  int q, x;
+} PolyEdge;
+
+/** Writable state of a convex polygon being drawn: the span of the 
+ *  last row asked for (relative to center), and its edges, so the next 
+ *  row costs an add per edge.  May be shared by several shapes, but 
+ *  shapes drawn by overlapping layers will each restart their walk on 
+ *  every pixel unless each has its own.
+ */
+typedef struct {
+  const void *shape;		/**< last walked, 0 for none */
+  Vec2 center;
+  int row;
+  int colMin, colMax;		/**< colMin > colMax if row is empty */
+  PolyEdge side[2];		/**< left, right */
+} PolyWalk;
+
+/** AbShape convex polygon
+ *
+ *  vertices are (col, row) relative to the center, listed clockwise
+ *  as seen on screen.  A pixel is within the shape if its center is
+ *  within (or on the edge of) the polygon.
+ */
+typedef struct AbConvexPoly_s {
+  void (*getBounds)(const struct AbConvexPoly_s *poly, const Vec2 *centerPos, Region *bounds);
+  int (*check)(const struct AbConvexPoly_s *poly, const Vec2 *centerPos, const Vec2 *pixel);
+  void (*rowSpans)(const struct AbConvexPoly_s *poly, const Vec2 *centerPos, int row, SpanFn emit, void *ctx);
+  const signed char (*vertices)[2];
+  const u_char count;		/**< of vertices */
+  PolyWalk *walk;
+} AbConvexPoly;
+
+/** As required by AbShape
+ */
+void abConvexPolyGetBounds(const AbConvexPoly *poly, const Vec2 *centerPos, Region *bounds);
+
+/** As required by AbShape
+ */
+int abConvexPolyCheck(const AbConvexPoly *poly, const Vec2 *centerPos, const Vec2 *pixel);
+
+/** As required by AbShape
+ */
+void abConvexPolyRowSpans(const AbConvexPoly *poly, const Vec2 *centerPos, int row, SpanFn emit, void *ctx);
+
+/** AbShape triangle: an AbConvexPoly with its three vertices in place
+ */
+typedef struct AbTriangle_s {
+  void (*getBounds)(const struct AbTriangle_s *tri, const Vec2 *centerPos, Region *bounds);
+  int (*check)(const struct AbTriangle_s *tri, const Vec2 *centerPos, const Vec2 *pixel);
+  void (*rowSpans)(const struct AbTriangle_s *tri, const Vec2 *centerPos, int row, SpanFn emit, void *ctx);
+  const signed char vertices[3][2]; /**< (col, row), clockwise */
+  PolyWalk *walk;
+} AbTriangle;
+
+/** As required by AbShape
+ */
+void abTriangleGetBounds(const AbTriangle *tri, const Vec2 *centerPos, Region *bounds);
+
+/** As required by AbShape
+ */
+int abTriangleCheck(const AbTriangle *tri, const Vec2 *centerPos, const Vec2 *pixel);
+
+/** As required by AbShape
+ */
+void abTriangleRowSpans(const AbTriangle *tri, const Vec2 *centerPos, int row, SpanFn emit, void *ctx);
+
+/** Sweep times are in 1/SWEEP_ONE of a step (of movement by velocity) */
+#define SWEEP_ONE 256
+
+/** When and how a moving region first touches another during a step
+ */
+typedef struct {
+  u_int time;			/**< 0 (at start) .. SWEEP_ONE (at end) */
+  Vec2 normal;			/**< -1, 0 or 1 per axis: away from the contact */
+} Sweep;
+
+/** True if moving, displaced by velocity over one step, comes to share 
+ *  a pixel with obstacle.  Fills hit with the first such time (rounded 
+ *  down) and the axis (or axes, at a corner) touched.  Regions that 
+ *  only share their edge pixels (along an axis moved toward the 
+ *  obstacle) at the start are reported at time 0; regions overlapping 
+ *  further at the start are not reported.
+ */
+int sweepRegion(const Region *moving, const Vec2 *velocity, const Region *obstacle, Sweep *hit);
+
+/** True if moving, displaced by velocity over one step, reaches fence's
+ *  edge while heading out of it (at time 0 if already beyond it).  
+ *  Fills hit as sweepRegion, with normal pointing back within fence.
+ */
+int sweepWithin(const Region *moving, const Vec2 *velocity, const Region *fence, Sweep *hit);
+
+/** (num << 8) / den, for 0 <= num <= den, by shift and subtract: 
+ *  the time (in 1/SWEEP_ONE) to cover num pixels at den pixels per step.
+ */
+u_int sweepFrac(u_int num, u_int den);
+
+/** value * time / SWEEP_ONE, rounded toward zero */
+int sweepScale(int value, u_int time);
+
+/** Move pos as far as velocity carries it by time (in 1/SWEEP_ONE) */
+void sweepMove(Vec2 *pos, const Vec2 *velocity, u_int time);
+
+/** Pixels per side of a tile */
+#define TILE_SIZE 8
+
+/** Tile map: a background built of 8x8 tiles, all in flash
+ *
+ *  map holds rows x cols tile indices (row by row) covering the screen
+ *  from its top left corner.  Each tile is 32 bytes: 8 rows of 8 4-bit
+ *  palette indices, the left pixel of each byte in its high nibble.
+ *  Pixels beyond the map are bgColor.
+ */
+typedef struct {
+  u_char cols, rows;		/**< of tiles */
+  const u_char *map;
+  const u_char *tiles;
+  const u_int *palette;		/**< up to 16 BGR colors */
+} TileMap;
+
+/** Color of the tile map's pixel at (col, row) */
+u_int tileMapColor(const TileMap *tileMap, int col, int row);
+
+/** The tile indices of the map row holding (pixel) row, or 0 if it is
+ *  beyond the map: look it up once per row, for tileMapRowColor
+ */
+const u_char *tileMapRowTiles(const TileMap *tileMap, int row);
+
+/** As tileMapColor, with mapRow = tileMapRowTiles(tileMap, row) */
+u_int tileMapRowColor(const TileMap *tileMap, const u_char *mapRow, int col, int row);
+
+/** Store the colors of the tile map's pixels colMin..colMax (on the 
+ *  screen) of row in line
+ */
+void tileMapRow(const TileMap *tileMap, int row, int colMin, int colMax, u_int *line);
+
+/** Draw the tile map alone, over the whole screen, through a single
+ *  window: each pixel row is streamed from the rows of its tiles.
+ */
+void tileMapDraw(const TileMap *tileMap);
+
+/** If not 0, layers are drawn over this tile map rather than bgColor:
+ *  redrawing a region (e.g. by movLayerDraw) repaints the tiles under 
+ *  it.
+ */
+extern const TileMap *bgTileMap;
+
 /** Linked list of Layers.  
  * 
  *  Each layer contains
@@ -175,10 +472,180 @@ void layerGetBounds(const Layer *l, Region *bounds);
 void layerInit(Layer *layers);
 
 /** Render all layers.   
- *  Pixels that are not contained by a layer are set to bgColor.
+ *  Pixels that are not contained by a layer are set to bgColor (or 
+ *  bgTileMap's pixels).
  */
 void layerDraw(Layer *layers);
 
+/** Start rendering all layers a few rows at a time (by layerDrawStep),
+ *  so that a program can respond to input and run its simulation while
+ *  the screen is painted.
+ */
+void layerDrawBegin(Layer *layers);
+
+/** Render up to rows more rows (from the top) of the screen begun by
+ *  layerDrawBegin.  Layers that move meanwhile are drawn where they are
+ *  when their rows are reached.
+ *
+ *  \return True while rows remain to be drawn
+ */
+int layerDrawStep(u_char rows);
+
+/** Render all layers within region (clipped to the screen).
+ *  Pixels that are not contained by a layer are set to bgColor (or 
+ *  bgTileMap's pixels).  See layerDrawMode.
+ */
+void layerDrawRegion(Layer *layers, const Region *region);
+
+/** Columns in layerDrawRegion's line buffer (on the stack, 2 bytes 
+ *  each, screenWidth at most).  Wider regions are drawn in strips.
+ */
+#ifndef LAYER_LINE_COLS
+#define LAYER_LINE_COLS 32
+#endif
+
+/** Bits per pixel (2 or 4) of layerDrawRegion's band buffer */
+#ifndef BAND_BPP
+#define BAND_BPP 2
+#endif
+
+/** Rows of a screenWidth wide band: the band buffer (on the stack) is
+ *  BAND_ROWS * screenWidth * BAND_BPP / 8 bytes.  Narrower regions are
+ *  drawn in proportionally taller bands.  The line and band buffers are
+ *  one buffer, the larger of the two.
+ */
+#ifndef BAND_ROWS
+#define BAND_ROWS 4
+#endif
+
+/** How layerDraw and layerDrawRegion render */
+#define LAYER_DRAW_PIXELS 0	/**< probe every layer for each pixel as it is sent */
+#define LAYER_DRAW_LINES 1	/**< compose each row (layerComposeRow), then send it */
+#define LAYER_DRAW_BANDS 2	/**< compose bands of rows as palette indices, then send them */
+
+/** LAYER_DRAW_PIXELS (initially), _LINES or _BANDS.
+ *
+ *  Bands are rows of BAND_BPP palette indices: the palette is bgColor
+ *  and the colors of the layers in the band (so up to 4 or 16 colors).
+ *  Layers' row spans are filled into the band a byte (of 4 or 2 
+ *  pixels) at a time, and expanded by lcd_writeIndexed as they are 
+ *  sent.  Bands needing more colors, and bgTileMap backgrounds, are 
+ *  drawn as with LAYER_DRAW_LINES.
+ */
+extern u_char layerDrawMode;
+
+/** Compose the colors of columns colMin..colMax of row in line: the
+ *  background (bgColor or bgTileMap), then each layer's row spans, 
+ *  from the lowest layer up.
+ *
+ *  \param layers (in) All layers, the top one first
+ *  \param line (out) colMax - colMin + 1 colors
+ */
+void layerComposeRow(Layer *layers, int row, int colMin, int colMax, u_int *line);
+
+/** Change one character of the AbText in textLayer and repaint only
+ *  that character's cell (through all layers).  Does nothing if the
+ *  character is unchanged.
+ *
+ *  \param textLayer (in) Layer whose abShape is an AbText
+ *  \param layers (in) All layers, for repainting
+ *  \param index (in) Position of the character within the text
+ *  \param c (in) New character
+ */
+void layerTextSetChar(Layer *textLayer, Layer *layers, u_char index, char c);
+
+/** Show value (formatted as by lcdnum.h's numCharsInit, right-aligned 
+ *  in the text's len characters) in textLayer's AbText, repainting only 
+ *  the characters that change.
+ */
+void layerTextSetNumber(Layer *textLayer, Layer *layers, int value, u_char format);
+
+/** MovLayer velocities are Fixes (8.8): MOV_ONE is a pixel per step */
+#define MOV_SHIFT FIX_SHIFT
+#define MOV_ONE FIX_ONE
+
+/** Moving Layer
+ *  Linked list of layer references
+ *  Velocity represents one iteration of change (direction & magnitude),
+ *  in 1/MOV_ONE pixels.  The layer's posNext is its position rounded to
+ *  pixels; frac holds the rest (-MOV_ONE/2 .. MOV_ONE/2-1 per axis).
+ */
+typedef struct MovLayer_s {
+  Layer *layer;
+  Vec2 velocity;
+  struct MovLayer_s *next;
+  signed char frac[2];		/* initially 0 */
+} MovLayer;
+
+/** Pixels (on each axis) that ml's posNext changes by when moved by its
+ *  velocity this step
+ */
+void movLayerStep(const MovLayer *ml, Vec2 *step);
+
+/** Move ml's posNext (and frac) by its velocity */
+void movLayerMove(MovLayer *ml);
+
+/** Move each moving layer to its posNext (with interrupts briefly
+ *  disabled, since interrupt handlers update posNext), then repaint
+ *  the union of its old and new bounds through all layers.  Layers
+ *  whose (rounded) position did not change are not repainted.
+ */
+void movLayerDraw(MovLayer *movLayers, Layer *layers);
+
+/** Collision groups (bits of Collider's group and mask) */
+#define COLLIDE_FENCE 0x80	/**< the world's fence: set in mask to stay within it */
+
+/** Collision responses */
+#define COLLIDE_BOUNCE 0	/**< reverse velocity along the contact normal */
+#define COLLIDE_STOP 1		/**< zero velocity along the contact normal */
+#define COLLIDE_TRIGGER 2	/**< no change to motion: only report the contact */
+
+/** A layer registered for collisions.
+ *
+ *  A collider responds to contacts with colliders whose group shares a
+ *  bit with its mask.  Moving colliders (mover != 0) responding with
+ *  BOUNCE or STOP stop at the first contact of a step (dropping any
+ *  fraction of a pixel), with their velocity changed for the next step.
+ */
+typedef struct Collider_s {
+  Layer *layer;
+  MovLayer *mover;		/**< its velocity, or 0 if it never moves */
+  u_char group, mask;		/**< what it is, and what it responds to */
+  u_char response;		/**< COLLIDE_BOUNCE, _STOP or _TRIGGER */
+  u_char flags;			/**< (used by collisionStep) */
+  Region bounds;		/**< (swept over the step by collisionStep) */
+  struct Collider_s *next;	/**< (kept sorted by bounds' left edge) */
+} Collider;
+
+/** Called for each contact a collider responds to (other is 0 at the
+ *  world's fence); normal points away from the contact.
+ */
+typedef void (*CollideFn)(Collider *self, Collider *other, const Vec2 *normal);
+
+/** Colliders that may touch one another */
+typedef struct {
+  Collider *colliders;		/**< (list built by colliderAdd) */
+  const Region *fence;		/**< colliders with COLLIDE_FENCE in mask stay within, or 0 */
+  CollideFn onCollide;		/**< or 0 */
+  u_int pairsTested;		/**< pairs tested exactly by the last collisionStep */
+} CollisionWorld;
+
+/** Register collider with world (c's fields other than flags, bounds
+ *  and next must be set)
+ */
+void colliderAdd(CollisionWorld *world, Collider *c);
+
+/** Advance every moving collider by its velocity (as movLayerMove),
+ *  resolving contacts.  Candidate pairs are found by sort and sweep
+ *  along columns: the list stays sorted from step to step, so
+ *  re-sorting is nearly linear.  Contacts are found at the time of
+ *  impact of the movers' bounding boxes, then stepped on (a pixel at a
+ *  time, so thin shapes are not skipped over) until the shapes' row 
+ *  spans meet: shapes whose boxes meet but which pass each other are 
+ *  not stopped.
+ */
+void collisionStep(CollisionWorld *world);
+
 /** Background color.
   */
 extern u_int bgColor;		/*  background color */
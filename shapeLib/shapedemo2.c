@@ -3,19 +3,40 @@
 #include "lcddraw.h"
 #include "shape.h"
 
-AbRect rect10 = {abRectGetBounds, abRectCheck, 10,10};
-AbRArrow arrow30 = {abRArrowGetBounds, abRArrowCheck, 30};
+AbRect rect10 = {abRectGetBounds, abRectCheck, abRectRowSpans, 10,10};
+AbRArrow arrow30 = {abRArrowGetBounds, abRArrowCheck, abRArrowRowSpans, 30};
+
+PolyWalk triWalk, hexWalk;	/* each shape's row walk */
+AbTriangle tri20 = {abTriangleGetBounds, abTriangleCheck, abTriangleRowSpans,
+		    {{0,-15}, {15,12}, {-15,12}}, &triWalk};
+const signed char hexVertices[][2] = {{-8,-14}, {8,-14}, {16,0}, {8,14}, {-8,14}, {-16,0}};
+AbConvexPoly hex16 = {abConvexPolyGetBounds, abConvexPolyCheck, abConvexPolyRowSpans,
+		      hexVertices, 6, &hexWalk};
 
 
 Region fence = {{10,30}, {SHORT_EDGE_PIXELS-10, LONG_EDGE_PIXELS-10}};
 
 
+Layer layer4 = {
+  (AbShape *)&hex16,
+  {screenWidth/2-30, screenHeight/2-40},    /* position */
+  {0,0}, {0,0},				    /* last & next pos */
+  COLOR_GREEN,
+  0,
+};
+Layer layer3 = {
+  (AbShape *)&tri20,
+  {screenWidth/2+25, screenHeight/2-40},    /* position */
+  {0,0}, {0,0},				    /* last & next pos */
+  COLOR_YELLOW,
+  &layer4,
+};
 Layer layer2 = {
   (AbShape *)&arrow30,
   {screenWidth/2+40, screenHeight/2+10}, 	    /* position */
   {0,0}, {0,0},				    /* last & next pos */
   COLOR_BLACK,
-  0,
+  &layer3,
 };
 Layer layer1 = {
   (AbShape *)&rect10,
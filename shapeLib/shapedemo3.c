@@ -17,7 +17,14 @@ abSlicedRectCheck(const AbRect *rect, const Vec2 *centerPos, const Vec2 *pixel)
     return abRectCheck(rect, centerPos, pixel);
 }
 
-AbRect rect10 = {abRectGetBounds, abSlicedRectCheck, 10,10};;
+// spans found by probing abSlicedRectCheck
+void
+abSlicedRectRowSpans(const AbRect *rect, const Vec2 *centerPos, int row, SpanFn emit, void *ctx)
+{
+  abShapeCheckSpans((const AbShape *)rect, centerPos, row, emit, ctx);
+}
+
+AbRect rect10 = {abRectGetBounds, abSlicedRectCheck, abSlicedRectRowSpans, 10,10};;
 
 
 Region fence = {{10,30}, {SHORT_EDGE_PIXELS-10, LONG_EDGE_PIXELS-10}};
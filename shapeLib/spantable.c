@@ -0,0 +1,56 @@
+#include "shape.h"
+
+/* first & limit pair of table row (0 <= row < height) */
+static void
+tableRow(const AbSpanTable *table, int row, const u_char **first, const u_char **limit)
+{
+  const u_char *spans = table->spans;
+  if (table->folded && 2 * row >= table->height)
+    row = table->height - 1 - row; /* mirror of lower half */
+  if (table->rowIndex) {
+    *first = spans + 2 * table->rowIndex[row];
+    *limit = spans + 2 * table->rowIndex[row + 1];
+  } else {
+    *first = spans + 2 * row;
+    *limit = *first + 2;
+  }
+}
+
+void
+abSpanTableGetBounds(const AbSpanTable *table, const Vec2 *centerPos, Region *bounds)
+{
+  bounds->topLeft.axes[0] = centerPos->axes[0] - table->originCol;
+  bounds->topLeft.axes[1] = centerPos->axes[1] - table->originRow;
+  bounds->botRight.axes[0] = bounds->topLeft.axes[0] + table->width - 1;
+  bounds->botRight.axes[1] = bounds->topLeft.axes[1] + table->height - 1;
+  regionClipScreen(bounds);
+}
+
+int
+abSpanTableCheck(const AbSpanTable *table, const Vec2 *centerPos, const Vec2 *pixel)
+{
+  const u_char *span, *limit;
+  int col = pixel->axes[0] - centerPos->axes[0] + table->originCol;
+  int row = pixel->axes[1] - centerPos->axes[1] + table->originRow;
+  if (col < 0 || row < 0 || col >= table->width || row >= table->height)
+    return 0;
+  tableRow(table, row, &span, &limit);
+  for (; span < limit && span[0] <= col; span += 2) /* spans ascend */
+    if (col <= span[1])
+      return 1;
+  return 0;
+}
+
+void
+abSpanTableRowSpans(const AbSpanTable *table, const Vec2 *centerPos, int row, SpanFn emit, void *ctx)
+{
+  const u_char *span, *limit;
+  int left = centerPos->axes[0] - table->originCol;
+  row = row - centerPos->axes[1] + table->originRow;
+  if (row < 0 || row >= table->height)
+    return;
+  tableRow(table, row, &span, &limit);
+  for (; span < limit; span += 2)
+    if (span[0] <= span[1])	/* skip empty rows */
+      (*emit)(ctx, left + span[0], left + span[1]);
+}
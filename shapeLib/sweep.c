@@ -0,0 +1,110 @@
+#include "shape.h"
+
+#define SWEEP_BEFORE (-1)		/* clamped times outside the step */
+#define SWEEP_AFTER (SWEEP_ONE + 1)
+
+u_int
+sweepFrac(u_int num, u_int den)
+{
+  u_int quot = 0;
+  u_char bit;
+  for (bit = 0; bit <= 8; bit++) { /* 9 quotient bits: 0..SWEEP_ONE */
+    quot <<= 1;
+    if (num >= den) {
+      num -= den;
+      quot |= 1;
+    }
+    num <<= 1;
+  }
+  return quot;
+}
+
+int
+sweepScale(int value, u_int time)
+{
+  unsigned long scaled;
+  if (value < 0)
+    return -sweepScale(-value, time);
+  scaled = (unsigned long)value * time;
+  return scaled >> 8;
+}
+
+void
+sweepMove(Vec2 *pos, const Vec2 *velocity, u_int time)
+{
+  pos->axes[0] += sweepScale(velocity->axes[0], time);
+  pos->axes[1] += sweepScale(velocity->axes[1], time);
+}
+
+/* time to cover dist at speed (> 0), clamped to just outside the step */
+static int
+sweepTime(int dist, int speed)
+{
+  if (dist < 0)
+    return SWEEP_BEFORE;
+  if (dist > speed)
+    return SWEEP_AFTER;
+  return sweepFrac(dist, speed);
+}
+
+int
+sweepRegion(const Region *moving, const Vec2 *velocity, const Region *obstacle, Sweep *hit)
+{
+  int entry[2], exit[2];
+  u_char axis;
+  for (axis = 0; axis < 2; axis++) {
+    int v = velocity->axes[axis];
+    int lo = moving->topLeft.axes[axis], hi = moving->botRight.axes[axis];
+    int obsLo = obstacle->topLeft.axes[axis], obsHi = obstacle->botRight.axes[axis];
+    if (v > 0) {
+      entry[axis] = sweepTime(obsLo - hi, v);
+      exit[axis] = sweepTime(obsHi - lo, v);
+    } else if (v < 0) {
+      entry[axis] = sweepTime(lo - obsHi, -v);
+      exit[axis] = sweepTime(hi - obsLo, -v);
+    } else if (hi < obsLo || lo > obsHi) {
+      return 0;			/* never overlap on this axis */
+    } else {
+      entry[axis] = SWEEP_BEFORE;
+      exit[axis] = SWEEP_AFTER;
+    }
+  }
+  {
+    int first = entry[0] > entry[1] ? entry[0] : entry[1];
+    int last = exit[0] < exit[1] ? exit[0] : exit[1];
+    if (first < 0 || first > SWEEP_ONE || first > last)
+      return 0;			/* overlapping already, too late, or never */
+    hit->time = first;
+    for (axis = 0; axis < 2; axis++) /* the axis (or axes) touched last */
+      hit->normal.axes[axis] = entry[axis] == first ? 
+	(velocity->axes[axis] > 0 ? -1 : 1) : 0;
+  }
+  return 1;
+}
+
+int
+sweepWithin(const Region *moving, const Vec2 *velocity, const Region *fence, Sweep *hit)
+{
+  int time[2];
+  int first;
+  u_char axis;
+  for (axis = 0; axis < 2; axis++) {
+    int v = velocity->axes[axis];
+    if (v > 0)
+      time[axis] = sweepTime(fence->botRight.axes[axis] - moving->botRight.axes[axis], v);
+    else if (v < 0)
+      time[axis] = sweepTime(moving->topLeft.axes[axis] - fence->topLeft.axes[axis], -v);
+    else
+      time[axis] = SWEEP_AFTER;
+    if (time[axis] == SWEEP_BEFORE)	/* already beyond, moving out */
+      time[axis] = 0;
+  }
+  first = time[0] < time[1] ? time[0] : time[1];
+  if (first > SWEEP_ONE)
+    return 0;
+  hit->time = first;
+  for (axis = 0; axis < 2; axis++)
+    hit->normal.axes[axis] = time[axis] == first ? 
+      (velocity->axes[axis] > 0 ? -1 : 1) : 0;
+  return 1;
+}
@@ -0,0 +1,66 @@
+#include "lcdutils.h"
+#include "lcddraw.h"
+#include "shape.h"
+
+// compute bounding box in screen coordinates for text centered at centerPos
+void
+abTextGetBounds(const AbText *text, const Vec2 *centerPos, Region *bounds)
+{
+  u_char font = text->font;
+  int width = text->len * fontAdvance[font] - (fontAdvance[font] - fontWidth[font]);
+  int height = fontHeight[font];
+  bounds->topLeft.axes[0] = centerPos->axes[0] - (width >> 1);
+  bounds->topLeft.axes[1] = centerPos->axes[1] - (height >> 1);
+  bounds->botRight.axes[0] = bounds->topLeft.axes[0] + width - 1;
+  bounds->botRight.axes[1] = bounds->topLeft.axes[1] + height - 1;
+}
+
+// true if pixel is in the foreground of one of text's glyphs
+int
+abTextCheck(const AbText *text, const Vec2 *centerPos, const Vec2 *pixel)
+{
+  Region bounds;
+  u_char font = text->font, advance = fontAdvance[font], index = 0;
+  int col, row;
+  abTextGetBounds(text, centerPos, &bounds);
+  col = pixel->axes[0] - bounds.topLeft.axes[0];
+  row = pixel->axes[1] - bounds.topLeft.axes[1];
+  if (col < 0 || row < 0 || pixel->axes[0] > bounds.botRight.axes[0] 
+      || pixel->axes[1] > bounds.botRight.axes[1])
+    return 0;
+  while (col >= advance) {	/* find the glyph (without dividing) */
+    col -= advance;
+    index++;
+  }
+  return col < fontWidth[font] && fontPixel(font, text->text[index], col, row);
+}
+
+// emit each run of foreground pixels of each glyph on row
+void
+abTextRowSpans(const AbText *text, const Vec2 *centerPos, int row, SpanFn emit, void *ctx)
+{
+  Region bounds;
+  u_char font = text->font, width = fontWidth[font], index;
+  int glyphCol;
+  abTextGetBounds(text, centerPos, &bounds);
+  if (row < bounds.topLeft.axes[1] || row > bounds.botRight.axes[1])
+    return;
+  row -= bounds.topLeft.axes[1];
+  glyphCol = bounds.topLeft.axes[0];
+  for (index = 0; index < text->len; index++, glyphCol += fontAdvance[font]) {
+    u_int bits = fontRowBits(font, text->text[index], row);
+    u_int mask = 1 << (width - 1);
+    int col = glyphCol, runStart;
+    while (bits) {		/* for each run of set bits, left to right */
+      while (!(bits & mask)) {
+	mask >>= 1; col++;
+      }
+      runStart = col;
+      while (bits & mask) {
+	bits &= ~mask;
+	mask >>= 1; col++;
+      }
+      (*emit)(ctx, runStart, col - 1);
+    }
+  }
+}
@@ -0,0 +1,153 @@
+/** \file tiledemo.c
+ *  \brief A level screen built from a tile map, with a square bouncing
+ *  over it: each step repaints only the tiles under the square.
+ */
+#include <msp430.h>
+#include <libTimer.h>
+#include "lcdutils.h"
+#include "lcddraw.h"
+#include "shape.h"
+
+const u_int levelPalette[] = {
+  COLOR_SKY_BLUE, COLOR_WHITE, COLOR_FIREBRICK, COLOR_GRAY,
+  COLOR_GREEN, COLOR_DARK_GREEN, COLOR_BROWN
+};
+
+/** Tiles: 8 rows of 8 palette indices (4 bytes) each */
+enum {SKY, CLOUD, BRICK, GRASS, DIRT};
+const u_char levelTiles[] = {
+  0x00, 0x00, 0x00, 0x00,	/* SKY */
+  0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00,
+
+  0x00, 0x00, 0x00, 0x00,	/* CLOUD */
+  0x00, 0x11, 0x11, 0x00,
+  0x01, 0x11, 0x11, 0x10,
+  0x11, 0x11, 0x11, 0x11,
+  0x11, 0x11, 0x11, 0x11,
+  0x01, 0x11, 0x11, 0x10,
+  0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00,
+
+  0x22, 0x22, 0x22, 0x23,	/* BRICK */
+  0x22, 0x22, 0x22, 0x23,
+  0x22, 0x22, 0x22, 0x23,
+  0x33, 0x33, 0x33, 0x33,
+  0x22, 0x23, 0x22, 0x22,
+  0x22, 0x23, 0x22, 0x22,
+  0x22, 0x23, 0x22, 0x22,
+  0x33, 0x33, 0x33, 0x33,
+
+  0x45, 0x44, 0x45, 0x44,	/* GRASS */
+  0x44, 0x54, 0x44, 0x54,
+  0x44, 0x44, 0x44, 0x44,
+  0x66, 0x66, 0x66, 0x66,
+  0x66, 0x63, 0x66, 0x66,
+  0x66, 0x66, 0x66, 0x66,
+  0x66, 0x66, 0x66, 0x36,
+  0x66, 0x66, 0x66, 0x66,
+
+  0x66, 0x66, 0x66, 0x66,	/* DIRT */
+  0x66, 0x36, 0x66, 0x66,
+  0x66, 0x66, 0x66, 0x66,
+  0x66, 0x66, 0x66, 0x36,
+  0x66, 0x66, 0x66, 0x66,
+  0x63, 0x66, 0x66, 0x66,
+  0x66, 0x66, 0x66, 0x66,
+  0x66, 0x66, 0x63, 0x66,
+};
+
+#define S SKY
+#define C CLOUD
+#define B BRICK
+#define G GRASS
+#define D DIRT
+const u_char levelMap[20][16] = {
+  {S,S,S,S,S,S,S,S,S,S,S,S,S,S,S,S},
+  {S,S,C,C,S,S,S,S,S,S,S,S,S,S,S,S},
+  {S,S,S,S,S,S,S,S,S,C,C,C,S,S,S,S},
+  {S,S,S,S,S,S,S,S,S,S,S,S,S,S,S,S},
+  {S,S,S,S,S,S,S,S,S,S,S,S,S,S,S,S},
+  {S,S,S,S,S,S,C,C,S,S,S,S,S,S,C,S},
+  {S,S,S,S,S,S,S,S,S,S,S,S,S,S,S,S},
+  {S,S,S,S,S,S,S,S,S,S,S,S,S,S,S,S},
+  {S,S,S,S,S,S,S,S,S,S,B,B,B,B,S,S},
+  {S,S,S,S,S,S,S,S,S,S,S,S,S,S,S,S},
+  {S,S,S,S,S,S,S,S,S,S,S,S,S,S,S,S},
+  {S,B,B,B,B,S,S,S,S,S,S,S,S,S,S,S},
+  {S,S,S,S,S,S,S,S,S,S,S,S,S,S,S,S},
+  {S,S,S,S,S,S,S,S,S,S,S,S,S,S,S,S},
+  {S,S,S,S,S,S,S,B,B,B,S,S,S,S,S,S},
+  {S,S,S,S,S,S,S,S,S,S,S,S,S,S,S,S},
+  {S,S,S,S,S,S,S,S,S,S,S,S,S,S,S,S},
+  {G,G,G,G,G,S,S,G,G,G,G,G,G,G,G,G},
+  {D,D,D,D,D,B,B,D,D,D,D,D,D,D,D,D},
+  {D,D,D,D,D,D,D,D,D,D,D,D,D,D,D,D},
+};
+#undef S
+#undef C
+#undef B
+#undef G
+#undef D
+
+const TileMap level = {16, 20, &levelMap[0][0], levelTiles, levelPalette};
+
+u_int bgColor = COLOR_BLACK;	/**< (beyond the map) */
+
+AbRect square = {abRectGetBounds, abRectCheck, abRectRowSpans, {3,3}};
+
+Layer squareLayer = {
+  (AbShape *)&square,
+  {screenWidth/2, screenHeight/2},
+  {0,0}, {0,0},				    /* last & next pos */
+  COLOR_YELLOW,
+  0
+};
+
+MovLayer squareMover = { &squareLayer, {2*MOV_ONE, 3*MOV_ONE}, 0 };
+
+Region screen = {{0,0}, {screenWidth-1, screenHeight-1}};
+Collider squareCollider = {&squareLayer, &squareMover, 1, COLLIDE_FENCE, COLLIDE_BOUNCE};
+CollisionWorld world = {0, &screen, 0};
+
+#define STEP_TICKS 8		/**< about 30 steps/sec */
+
+void step()
+{
+  collisionStep(&world);
+}
+
+void render()
+{
+  movLayerDraw(&squareMover, &squareLayer); /**< repaints the tiles it leaves */
+}
+
+void main()
+{
+  configureClocks();
+  lcd_init();
+
+  bgTileMap = &level;		/**< layers are drawn over the tiles */
+  tileMapDraw(&level);
+  layerInit(&squareLayer);
+  colliderAdd(&world, &squareCollider);
+
+  frameLoopInit(STEP_TICKS);
+  enableWDTInterrupts();
+  or_sr(0x8);			/**< GIE (enable interrupts) */
+
+  for (;;)
+    frameLoopService(step, render); /**< CPU off until a step is due */
+}
+
+void __interrupt_vec(WDT_VECTOR) WDT()	/* 250 interrupts/sec */
+{
+  frameLoopTick();
+  if (frameStepsPending)
+    __bic_SR_register_on_exit(CPUOFF); /**< wake frameLoopService */
+}
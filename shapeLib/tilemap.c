@@ -0,0 +1,72 @@
+#include "lcdutils.h"
+#include "shape.h"
+
+const TileMap *bgTileMap = 0;
+
+const u_char *
+tileMapRowTiles(const TileMap *tileMap, int row)
+{
+  u_char tileRow = row >> 3;
+  if (tileRow >= tileMap->rows)
+    return 0;
+  return tileMap->map + tileRow * tileMap->cols;
+}
+
+u_int
+tileMapRowColor(const TileMap *tileMap, const u_char *mapRow, int col, int row)
+{
+  u_char tileCol = col >> 3, pixels;
+  if (!mapRow || tileCol >= tileMap->cols)
+    return bgColor;
+  pixels = tileMap->tiles[(mapRow[tileCol] << 5) + ((row & 7) << 2) + ((col & 7) >> 1)];
+  return tileMap->palette[(col & 1) ? pixels & 0xf : pixels >> 4];
+}
+
+u_int
+tileMapColor(const TileMap *tileMap, int col, int row)
+{
+  return tileMapRowColor(tileMap, tileMapRowTiles(tileMap, row), col, row);
+}
+
+void
+tileMapRow(const TileMap *tileMap, int row, int colMin, int colMax, u_int *line)
+{
+  u_char rowOffset = (row & 7) << 2;
+  const u_char *mapRow = tileMapRowTiles(tileMap, row);
+  int col;
+  for (col = colMin; col <= colMax; col++) {
+    u_char tileCol = col >> 3, pixels;
+    if (!mapRow || tileCol >= tileMap->cols) {
+      *line++ = bgColor;
+      continue;
+    }
+    pixels = tileMap->tiles[(mapRow[tileCol] << 5) + rowOffset + ((col & 7) >> 1)];
+    *line++ = tileMap->palette[(col & 1) ? pixels & 0xf : pixels >> 4];
+  }
+}
+
+void
+tileMapDraw(const TileMap *tileMap)
+{
+  u_char row, tileCol, i;
+  const u_char *mapRow = tileMap->map;
+  lcd_setArea(0, 0, screenWidth-1, screenHeight-1);
+  for (row = 0; row < screenHeight; row++) {
+    u_char rowOffset = (row & 7) << 2; /* of this pixel row within a tile */
+    if (row && !(row & 7))
+      mapRow += tileMap->cols;
+    for (tileCol = 0; tileCol < screenWidth >> 3; tileCol++) {
+      const u_char *pixels;
+      if (tileCol >= tileMap->cols || (row >> 3) >= tileMap->rows) {
+	for (i = 0; i < TILE_SIZE; i++)
+	  lcd_writeColor(bgColor);
+	continue;
+      }
+      pixels = tileMap->tiles + (mapRow[tileCol] << 5) + rowOffset;
+      for (i = 0; i < TILE_SIZE/2; i++) { /* two pixels per byte */
+	lcd_writeColor(tileMap->palette[pixels[i] >> 4]);
+	lcd_writeColor(tileMap->palette[pixels[i] & 0xf]);
+      }
+    }
+  }
+}
@@ -48,3 +48,10 @@ vec2Abs(Vec2 *vec)
       vec->axes[axis] = -val;
   }
 }
+
+void
+vec2Direction(Vec2 *result, Angle angle, Fix length)
+{
+  result->axes[0] = fixMul(fixCos(angle), length);
+  result->axes[1] = fixMul(fixSin(angle), length);
+}
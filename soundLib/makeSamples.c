@@ -0,0 +1,159 @@
+#include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
+#include "math.h"
+#include "assert.h"
+#include "sampleplayer.h"
+
+// Convert sound files to delta-coded Samples (see sampleplayer.h)
+//
+// usage: makeSamples outBase name source [name source ...]
+//   source is a PCM .wav file (8 or 16 bit, any rate, mono or stereo)
+//   or a synthetic chirp "sweep:startHz:endHz:ms"
+// writes outBase.c and outBase.h declaring "const Sample name;"
+
+#define MAX_SAMPLES 65535
+
+static unsigned char pcm[MAX_SAMPLES];	/* 8-bit unsigned, SAMPLE_RATE */
+
+static unsigned long readLE(FILE *fp, int bytes)
+{
+  unsigned long val = 0;
+  int i;
+  for (i = 0; i < bytes; i++)
+    val |= (unsigned long)fgetc(fp) << (8 * i);
+  return val;
+}
+
+/* read & resample (nearest) a PCM wav file into pcm[]; returns sample count */
+static long readWav(const char *filename)
+{
+  FILE *fp = fopen(filename, "rb");
+  char id[5] = {0};
+  int channels = 0, bits = 0;
+  long rate = 0, count = 0;
+  if (!fp) {
+    fprintf(stderr, "makeSamples: can't open %s\n", filename);
+    exit(1);
+  }
+  if (fread(id, 1, 4, fp) != 4 || strcmp(id, "RIFF")) goto bad;
+  readLE(fp, 4);
+  if (fread(id, 1, 4, fp) != 4 || strcmp(id, "WAVE")) goto bad;
+  while (fread(id, 1, 4, fp) == 4) {
+    unsigned long size = readLE(fp, 4);
+    if (!strcmp(id, "fmt ")) {
+      if (readLE(fp, 2) != 1) goto bad; /* PCM only */
+      channels = readLE(fp, 2);
+      rate = readLE(fp, 4);
+      readLE(fp, 6);		/* byte rate, block align */
+      bits = readLE(fp, 2);
+      fseek(fp, size - 16 + (size & 1), SEEK_CUR);
+    } else if (!strcmp(id, "data")) {
+      long frames, frame, bytesPerFrame;
+      if (!rate || (bits != 8 && bits != 16)) goto bad;
+      bytesPerFrame = channels * bits / 8;
+      frames = size / bytesPerFrame;
+      long start = ftell(fp);
+      for (count = 0; count < MAX_SAMPLES; count++) {
+	long sum = 0;
+	int ch;
+	frame = count * rate / SAMPLE_RATE;
+	if (frame >= frames) break;
+	fseek(fp, start + frame * bytesPerFrame, SEEK_SET);
+	for (ch = 0; ch < channels; ch++)
+	  sum += (bits == 8) ? (long)fgetc(fp) - 128 : (short)readLE(fp, 2) >> 8;
+	pcm[count] = 128 + sum / channels;
+      }
+      fclose(fp);
+      return count;
+    } else
+      fseek(fp, size + (size & 1), SEEK_CUR);
+  }
+ bad:
+  fprintf(stderr, "makeSamples: %s is not an 8/16 bit PCM wav file\n", filename);
+  exit(1);
+}
+
+/* square-wave chirp from startHz to endHz */
+static long makeSweep(const char *spec)
+{
+  double startHz, endHz, ms, phase = 0;
+  long count, i;
+  if (sscanf(spec, "sweep:%lf:%lf:%lf", &startHz, &endHz, &ms) != 3) {
+    fprintf(stderr, "makeSamples: bad sweep spec %s\n", spec);
+    exit(1);
+  }
+  count = ms * SAMPLE_RATE / 1000;
+  assert(count <= MAX_SAMPLES);
+  for (i = 0; i < count; i++) {
+    double hz = startHz + (endHz - startHz) * i / count;
+    phase += hz / SAMPLE_RATE;
+    pcm[i] = (phase - floor(phase) < 0.5) ? 64 : 192;
+  }
+  return count;
+}
+
+/* emit one Sample, choosing each delta to best track the input */
+static void encode(FILE *cfile, const char *name, long count)
+{
+  int level = pcm[0];
+  long i;
+  fprintf(cfile, "static const unsigned char %s_codes[%ld] = {", name, (count + 1) / 2);
+  for (i = 0; i < count; i += 2) {
+    int half, codes[2] = {8, 8}; /* code 8 = no change (pads odd length) */
+    for (half = 0; half < 2 && i + half < count; half++) {
+      int code, best = 8, bestErr = 1 << 30;
+      for (code = 0; code < 16; code++) {
+	int next = level + sampleDeltas[code];
+	int err = abs(next - pcm[i + half]);
+	if (next >= 0 && next <= 255 && err < bestErr) {
+	  best = code;
+	  bestErr = err;
+	}
+      }
+      codes[half] = best;
+      level += sampleDeltas[best];
+    }
+    fprintf(cfile, "%s0x%02x,", (i % 32) ? " " : "\n  ", codes[0] | (codes[1] << 4));
+  }
+  fprintf(cfile, "\n};\n\n");
+  fprintf(cfile, "const Sample %s = { %s_codes, %ld, %d };\n\n", name, name, count, pcm[0]);
+}
+
+int main(int argc, char **argv)
+{
+  char filename[100];
+  int arg;
+  if (argc < 4 || (argc & 1)) {
+    fprintf(stderr, "usage: makeSamples outBase name source [name source ...]\n");
+    return 1;
+  }
+  sprintf(filename, "%s.c", argv[1]);
+  FILE *cfile = fopen(filename, "w");
+  sprintf(filename, "%s.h", argv[1]);
+  FILE *hfile = fopen(filename, "w");
+  assert(cfile); assert(hfile);
+
+  fprintf(cfile, "// Automatically generated by makeSamples.\n");
+  fprintf(cfile, "#include \"sampleplayer.h\"\n\n");
+  fprintf(hfile, "// Automatically generated by makeSamples.\n");
+  fprintf(hfile, "#ifndef %s_included\n#define %s_included\n\n", argv[1], argv[1]);
+  fprintf(hfile, "#include \"sampleplayer.h\"\n\n");
+
+  for (arg = 2; arg < argc; arg += 2) {
+    const char *name = argv[arg], *source = argv[arg + 1];
+    long count = strncmp(source, "sweep:", 6) ? readWav(source) : makeSweep(source);
+    if (count == 0) {
+      fprintf(stderr, "makeSamples: %s is empty\n", source);
+      return 1;
+    }
+    encode(cfile, name, count);
+    fprintf(hfile, "extern const Sample %s; /* %ld samples, %ld bytes */\n",
+	    name, count, (count + 1) / 2);
+  }
+
+  fprintf(hfile, "\n#endif // included\n");
+  fclose(cfile);
+  fclose(hfile);
+  return 0;
+}
@@ -0,0 +1,130 @@
+/** \file samplebench.c
+ *  \brief Measures the cost of sample playback on movLayerDraw.
+ *
+ *  Renders the same sequence of moving-layer frames twice: once silent
+ *  and once while continuously playing a sample.  Displays both times
+ *  (in ms) and the slowdown (in tenths of a percent).  The red LED
+ *  indicates a slowdown of 10% or more.
+ */
+#include <msp430.h>
+#include <libTimer.h>
+#include <lcdutils.h>
+#include <lcddraw.h>
+#include <lcdnum.h>
+#include <shape.h>
+#include <abCircle.h>
+#include "sampleplayer.h"
+#include "benchSamples.h"
+
+#define RED_LED BIT0
+#define FRAMES 40
+#define REPORT_COL 90		/**< of the results' values */
+
+AbRect rect10 = {abRectGetBounds, abRectCheck, abRectRowSpans, {10,10}}; /**< 10x10 rectangle */
+
+AbRectOutline fieldOutline = {	/* playing field */
+  abRectOutlineGetBounds, abRectOutlineCheck, abRectOutlineRowSpans,
+  {screenWidth/2 - 10, screenHeight/2 - 10}
+};
+
+Layer fieldLayer = {		/* playing field as a layer */
+  (AbShape *) &fieldOutline,
+  {screenWidth/2, screenHeight/2},/**< center */
+  {0,0}, {0,0},				    /* last & next pos */
+  COLOR_BLACK,
+  0
+};
+
+Layer layer1 = {		/**< Layer with a red square */
+  (AbShape *)&rect10,
+  {screenWidth/2, screenHeight/2}, /**< center */
+  {0,0}, {0,0},				    /* last & next pos */
+  COLOR_RED,
+  &fieldLayer,
+};
+
+Layer layer0 = {		/**< Layer with an orange circle */
+  (AbShape *)&circle14,
+  {(screenWidth/2)+10, (screenHeight/2)+5}, /**< bit below & right of center */
+  {0,0}, {0,0},				    /* last & next pos */
+  COLOR_ORANGE,
+  &layer1,
+};
+
+MovLayer ml1 = { &layer1, {MOV_ONE, 2*MOV_ONE}, 0 }; 
+MovLayer ml0 = { &layer0, {2*MOV_ONE, MOV_ONE}, &ml1 }; 
+
+u_int bgColor = COLOR_BLUE;     /**< The background color */
+
+/** Advances moving layers within fence (as in shape-motion-demo) */
+void mlAdvance(MovLayer *ml, Region *fence)
+{
+  Vec2 newPos, step;
+  u_char axis;
+  Region shapeBoundary;
+  for (; ml; ml = ml->next) {
+    movLayerStep(ml, &step);	/**< whole pixels moved this step */
+    vec2Add(&newPos, &ml->layer->posNext, &step);
+    abShapeGetBounds(ml->layer->abShape, &newPos, &shapeBoundary);
+    for (axis = 0; axis < 2; axis ++) {
+      if ((shapeBoundary.topLeft.axes[axis] < fence->topLeft.axes[axis]) ||
+	  (shapeBoundary.botRight.axes[axis] > fence->botRight.axes[axis]) ) {
+	ml->velocity.axes[axis] = -ml->velocity.axes[axis]; /**< back within */
+      }	/**< if outside of fence */
+    } /**< for axis */
+    movLayerMove(ml);
+  } /**< for ml */
+}
+
+/** Render FRAMES frames from the same starting state; returns elapsed ms */
+u_int timeFrames(Region *fence, char playing)
+{
+  int frame;
+  Vec2 start0 = {(screenWidth/2)+10, (screenHeight/2)+5};
+  Vec2 start1 = {screenWidth/2, screenHeight/2};
+  layer0.posNext = start0; ml0.velocity.axes[0] = 2*MOV_ONE; ml0.velocity.axes[1] = MOV_ONE;
+  layer1.posNext = start1; ml1.velocity.axes[0] = MOV_ONE; ml1.velocity.axes[1] = 2*MOV_ONE;
+  ml0.frac[0] = ml0.frac[1] = ml1.frac[0] = ml1.frac[1] = 0;
+
+  stopwatchStart();
+  for (frame = 0; frame < FRAMES; frame++) {
+    if (playing && !samplePlaying())
+      samplePlay(&blip);	/* keep the decoder busy throughout */
+    mlAdvance(&ml0, fence);
+    movLayerDraw(&ml0, &layer0);
+  }
+  stopwatchStop();
+  sampleStop();
+  return stopwatchMs();
+}
+
+void main()
+{
+  Region fieldFence;
+  u_int silent, playing, slowdown;
+
+  P1DIR |= RED_LED;
+  P1OUT &= ~RED_LED;
+  configureClocks();
+  lcd_init();
+
+  layerInit(&layer0);
+  layerDraw(&layer0);
+  layerGetBounds(&fieldLayer, &fieldFence);
+  or_sr(0x8);			/**< GIE: stopwatch & sample interrupts */
+
+  silent = timeFrames(&fieldFence, 0);
+  playing = timeFrames(&fieldFence, 1);
+  slowdown = silent && playing > silent ? /* (timing noise can make it faster) */
+    ((unsigned long)(playing - silent) * 1000) / silent : 0; /* tenths of a percent */
+
+  clearScreen(COLOR_BLACK);
+  drawReportLine(0, "silent", silent, REPORT_COL);
+  drawReportLine(1, "playing", playing, REPORT_COL);
+  drawReportLine(2, "slowdown 0.1%", slowdown, REPORT_COL);
+  if (slowdown >= 100)
+    P1OUT |= RED_LED;		/* over the 10% budget */
+
+  for (;;)
+    or_sr(0x10);		/**< CPU OFF */
+}
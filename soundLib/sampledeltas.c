@@ -0,0 +1,8 @@
+#include "sampleplayer.h"
+
+/** "Fibonacci" deltas: fine steps for quiet passages, large for edges.
+ *  Also compiled into the host tool makeSamples.
+ */
+const signed char sampleDeltas[16] = {
+  -34, -21, -13, -8, -5, -3, -2, -1, 0, 1, 2, 3, 5, 8, 13, 21
+};
@@ -0,0 +1,64 @@
+/** \file sampleplayer.c
+ *  \brief Timer_A PWM sample playback.
+ *
+ *  TA0.1 (P2.6) drives the speaker in reset/set mode; CCR1 sets the
+ *  duty cycle.  The CCR0 interrupt fires once per PWM period and
+ *  decodes the next 4-bit delta.
+ */
+#include <msp430.h>
+#include "sampleplayer.h"
+
+static const unsigned char *nextCode;
+static unsigned int remaining;	/**< samples left to play */
+static unsigned char level;	/**< current 8-bit output level */
+static unsigned char highNibble; /**< next code is in upper nibble */
+
+void samplePlay(const Sample *sample)
+{
+  sampleStop();
+  nextCode = sample->codes;
+  remaining = sample->length;
+  level = sample->initial;
+  highNibble = 0;
+
+  P2SEL2 &= ~BIT6;		/* P2.6 is TA0.1 */
+  P2SEL |= BIT6;
+  P2DIR |= BIT6;
+  TA0CCR0 = (256 << SAMPLE_PWM_SHIFT) - 1;
+  TA0CCR1 = level << SAMPLE_PWM_SHIFT;
+  TA0CCTL1 = OUTMOD_7;		/* reset at CCR1, set at CCR0 */
+  TA0CTL = TASSEL_2 + MC_1;	/* SMCLK, up mode to CCR0 */
+  TA0CCTL0 = CCIE;
+}
+
+void sampleStop()
+{
+  TA0CCTL0 = 0;			/* no more decode interrupts */
+  TA0CCR1 = 0;			/* output stays low */
+  remaining = 0;
+}
+
+int samplePlaying()
+{
+  return remaining != 0;
+}
+
+/** Decode one sample per PWM period.  Kept short: this runs
+ *  SAMPLE_RATE times per second while a sample plays.
+ */
+void
+__interrupt_vec(TIMER0_A0_VECTOR) sampleDecode(){
+  unsigned char code;
+  if (!remaining) {
+    sampleStop();
+    return;
+  }
+  if (highNibble)
+    code = *nextCode++ >> 4;
+  else
+    code = *nextCode & 0x0f;
+  highNibble ^= 1;
+  level += sampleDeltas[code];
+  TA0CCR1 = level << SAMPLE_PWM_SHIFT;
+  remaining--;
+}
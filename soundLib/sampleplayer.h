@@ -0,0 +1,47 @@
+/** \file sampleplayer.h
+ *  \brief Plays delta-coded samples through Timer_A PWM on P2.6
+ */
+
+#ifndef sampleplayer_included
+#define sampleplayer_included
+
+/** PWM resolution: samples are 8 bits, the PWM period is 
+ *  256 << SAMPLE_PWM_SHIFT SMCLK cycles.  With SMCLK = 2MHz a shift of 1
+ *  yields 3906 samples/sec (one timer interrupt per sample).
+ */
+#ifndef SAMPLE_PWM_SHIFT
+#define SAMPLE_PWM_SHIFT 1
+#endif
+
+/** Samples per second.  makeSamples resamples input to this rate. */
+#define SAMPLE_RATE (2000000L / (256 << SAMPLE_PWM_SHIFT))
+
+/** A sound effect stored in flash as 4-bit delta codes
+ *
+ *  Each byte holds two codes (low nibble first).  A code indexes
+ *  sampleDeltas[], which is added to the previous 8-bit level.
+ *  The encoder never emits a delta that leaves 0..255, so the decoder
+ *  does not clamp.
+ */
+typedef struct {
+  const unsigned char *codes;	/**< (length + 1) / 2 bytes */
+  unsigned int length;		/**< number of samples */
+  unsigned char initial;	/**< level before the first delta */
+} Sample;
+
+/** Delta for each 4-bit code (shared by makeSamples) */
+extern const signed char sampleDeltas[16];
+
+/** Start playing sample (stops any sample already playing).
+ *  Takes over Timer_A0 (CCR0 & CCR1), so buzzer tones are silenced
+ *  until the sample completes.  Requires GIE.
+ */
+void samplePlay(const Sample *sample);
+
+/** Stop playback and silence the speaker */
+void sampleStop();
+
+/** True while a sample is playing */
+int samplePlaying();
+
+#endif // included
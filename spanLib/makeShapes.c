@@ -0,0 +1,444 @@
+/** \file makeShapes.c
+ *  \brief Host tool: compiles a shape description file into AbSpanTables.
+ *
+ *  usage: makeShapes descFile header.h
+ *
+ *  Each line of descFile describes one shape (# starts a comment):
+ *
+ *    ellipse  name halfWidth halfHeight
+ *    rrect    name halfWidth halfHeight cornerRadius
+ *    triangle name col0 row0 col1 row1 col2 row2
+ *    arrow    name right|left|up|down length headHalfWidth stemHalfWidth
+ *    mask     name width height
+ *    bitmap   name file.pbm [runs]
+ *
+ *  Ellipses and rounded rectangles are centered at centerPos.  Triangle 
+ *  vertices are relative to centerPos, and no pixel may be above or left
+ *  of it (tables' origins are u_chars).  Like AbRArrow, an arrow's 
+ *  centerPos is its tip.  A mask is followed by height lines of width 
+ *  characters ('#' within the shape, anything else outside) and is 
+ *  centered (rounding toward the top left).  A bitmap is read from a
+ *  PBM image (plain or raw; black pixels are within the shape), centered
+ *  like a mask, and written as an AbBitmap: a 1-bit mask, plus its runs
+ *  if "runs" is given.
+ *
+ *  Writes shapes/name.c for each shape (so that programs link only the
+ *  shapes they reference) and a header declaring them all.  Tables of
+ *  shapes that are symmetric top to bottom are folded (only the upper
+ *  half is stored).  Reports each table's flash footprint.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#define MAX_DIM 255		/* table coordinates are u_chars */
+#define GRID (2 * MAX_DIM + 1)	/* candidate pixels, centered on origin */
+
+static char grid[GRID][GRID];	/* [row][col]; origin at [MAX_DIM][MAX_DIM] */
+
+#define AT(col, row) grid[(row) + MAX_DIM][(col) + MAX_DIM]
+
+static int inRange(int v) { return v >= -MAX_DIM && v <= MAX_DIM; }
+
+static void
+rasterEllipse(long a, long b)
+{
+  int col, row;
+  for (row = -b; row <= b; row++)
+    for (col = -a; col <= a; col++)
+      AT(col, row) = b*b*col*col + a*a*row*row <= a*a*b*b;
+}
+
+static void
+rasterRRect(int halfWidth, int halfHeight, int radius)
+{
+  int col, row;
+  int cornerCol = halfWidth - radius, cornerRow = halfHeight - radius;
+  for (row = -halfHeight; row <= halfHeight; row++)
+    for (col = -halfWidth; col <= halfWidth; col++) {
+      int dCol = abs(col) - cornerCol, dRow = abs(row) - cornerRow;
+      AT(col, row) = dCol <= 0 || dRow <= 0 || dCol*dCol + dRow*dRow <= radius*radius;
+    }
+}
+
+/* twice the signed area of (a, b, p): which side of edge ab p is on */
+static long
+edge(const int *a, const int *b, int col, int row)
+{
+  return (long)(b[0] - a[0]) * (row - a[1]) - (long)(b[1] - a[1]) * (col - a[0]);
+}
+
+static void
+rasterTriangle(int v[3][2])
+{
+  int col, row;
+  for (row = -MAX_DIM; row <= MAX_DIM; row++)
+    for (col = -MAX_DIM; col <= MAX_DIM; col++) {
+      long e0 = edge(v[0], v[1], col, row);
+      long e1 = edge(v[1], v[2], col, row);
+      long e2 = edge(v[2], v[0], col, row);
+      AT(col, row) = (e0 >= 0 && e1 >= 0 && e2 >= 0) || (e0 <= 0 && e1 <= 0 && e2 <= 0);
+    }
+}
+
+/* right arrow with tip at origin, rotated to dir */
+static void
+rasterArrow(const char *dir, int length, int head, int stem)
+{
+  int col, row;
+  for (row = -length; row <= length; row++)
+    for (col = -length; col <= length; col++) {
+      int along, across;	/* along: distance behind tip */
+      if (!strcmp(dir, "right"))     { along = -col; across = row; }
+      else if (!strcmp(dir, "left")) { along = col;  across = row; }
+      else if (!strcmp(dir, "down")) { along = -row; across = col; }
+      else                           { along = row;  across = col; }
+      across = abs(across);
+      AT(col, row) = along >= 0 && along <= length &&
+	(along <= head ? across <= along : across <= stem);
+    }
+}
+
+static int
+rasterMask(FILE *desc, int width, int height)
+{
+  int col, row;
+  char line[2 * MAX_DIM];
+  for (row = 0; row < height; row++) {
+    if (!fgets(line, sizeof line, desc))
+      return 0;
+    for (col = 0; col < width && line[col] && line[col] != '\n'; col++)
+      AT(col - width/2, row - height/2) = line[col] == '#';
+  }
+  return 1;
+}
+
+/* next number (or raw image's first byte) of a PBM header, skipping comments */
+static int
+pbmInt(FILE *fp)
+{
+  int c, n;
+  while ((c = getc(fp)) == '#' || c == ' ' || c == '\t' || c == '\r' || c == '\n')
+    if (c == '#')
+      while ((c = getc(fp)) != '\n' && c != EOF)
+	;
+  ungetc(c, fp);
+  return fscanf(fp, "%d", &n) == 1 ? n : -1;
+}
+
+/* read a PBM image into the grid, centered as a mask; 0 if unreadable */
+static int
+rasterPbm(const char *filename, int *width, int *height)
+{
+  FILE *fp = fopen(filename, "rb");
+  int col, row, raw, c = 0;
+  if (!fp)
+    return 0;
+  if (getc(fp) != 'P' || ((raw = getc(fp)) != '4' && raw != '1')) {
+    fprintf(stderr, "makeShapes: %s is not a P1 or P4 PBM image\n", filename);
+    fclose(fp);
+    return 0;
+  }
+  raw = raw == '4';
+  *width = pbmInt(fp);
+  *height = pbmInt(fp);
+  if (*width <= 0 || *width > MAX_DIM || *height <= 0 || *height > MAX_DIM) {
+    fclose(fp);
+    return 0;
+  }
+  if (raw)
+    getc(fp);			/* the single whitespace before the bits */
+  for (row = 0; row < *height; row++)
+    for (col = 0; col < *width; col++) {
+      int bit;
+      if (raw) {
+	if (!(col & 7) && (c = getc(fp)) == EOF) {
+	  fclose(fp);
+	  return 0;
+	}
+	bit = (c >> (7 - (col & 7))) & 1;
+      } else {
+	while ((c = getc(fp)) != '0' && c != '1')
+	  if (c == EOF) {
+	    fclose(fp);
+	    return 0;
+	  }
+	bit = c == '1';
+      }
+      AT(col - *width/2, row - *height/2) = bit;
+    }
+  fclose(fp);
+  return 1;
+}
+
+/* number of spans on row of grid within cols colMin..colMax */
+static int
+countSpans(int row, int colMin, int colMax)
+{
+  int col, n = 0;
+  for (col = colMin; col <= colMax; col++)
+    if (AT(col, row) && (col == colMin || !AT(col-1, row)))
+      n++;
+  return n;
+}
+
+/* exit unless the shape's origin (offset -colMin, -rowMin from its top
+   left) fits the tables' u_char originCol & originRow */
+static void
+checkOrigin(const char *name, int colMin, int rowMin)
+{
+  if (colMin > 0 || rowMin > 0) {
+    fprintf(stderr, "makeShapes: %s has pixels only right of or below its origin "
+	    "(%d, %d): move it to include the origin's row and column\n", name, colMin, rowMin);
+    exit(1);
+  }
+}
+
+/* flash bytes of a table: spans, row index & AbSpanTable (16 bytes) */
+static int
+tableBytes(int nSpans, int indexed, int rowsStored)
+{
+  return 2 * nSpans + (indexed ? 2 * (rowsStored + 1) : 0) + 16;
+}
+
+/* write the span table of grid's pixels as shapes/name.c; returns flash bytes */
+static int
+emitTable(const char *name, FILE *header)
+{
+  int colMin = MAX_DIM, colMax = -MAX_DIM, rowMin = MAX_DIM, rowMax = -MAX_DIM;
+  int col, row, width, height, rowLast, indexed = 0, folded = 1;
+  int nSpans = 0, nSpansAll = 0, bytes, unfoldedBytes;
+  char filename[300];
+  FILE *fp;
+
+  for (row = -MAX_DIM; row <= MAX_DIM; row++) /* bounding box */
+    for (col = -MAX_DIM; col <= MAX_DIM; col++)
+      if (AT(col, row)) {
+	if (col < colMin) colMin = col;
+	if (col > colMax) colMax = col;
+	if (row < rowMin) rowMin = row;
+	if (row > rowMax) rowMax = row;
+      }
+  if (colMin > colMax) {
+    fprintf(stderr, "makeShapes: %s is empty\n", name);
+    exit(1);
+  }
+  width = colMax - colMin + 1; height = rowMax - rowMin + 1;
+  if (width > MAX_DIM || height > MAX_DIM) {
+    fprintf(stderr, "makeShapes: %s is larger than %dx%d\n", name, MAX_DIM, MAX_DIM);
+    exit(1);
+  }
+  checkOrigin(name, colMin, rowMin);
+  for (row = rowMin; row <= rowMax; row++) { /* count spans & check symmetry */
+    int rowSpans = countSpans(row, colMin, colMax);
+    if (rowSpans > 1)
+      indexed = 1;
+    nSpansAll += rowSpans ? rowSpans : 1; /* (empty rows take a pair if !indexed) */
+    for (col = colMin; col <= colMax; col++)
+      if (AT(col, row) != AT(col, rowMin + rowMax - row))
+	folded = 0;
+  }
+  rowLast = folded ? rowMin + (height + 1) / 2 - 1 : rowMax;
+
+  sprintf(filename, "shapes/%s.c", name);
+  fp = fopen(filename, "w");
+  assert(fp);
+  fprintf(fp, "// Automatically generated by makeShapes.\n");
+  fprintf(fp, "#include \"shape.h\"\n\n");
+  fprintf(fp, "static const u_char spans[] = {\n");
+  for (row = rowMin; row <= rowLast; row++) {
+    int any = 0;
+    fprintf(fp, "   ");
+    for (col = colMin; col <= colMax; col++)
+      if (AT(col, row) && (col == colMin || !AT(col-1, row))) {
+	int end = col;
+	while (end < colMax && AT(end+1, row))
+	  end++;
+	fprintf(fp, " %d,%d,", col - colMin, end - colMin);
+	nSpans++;
+	any = 1;
+      }
+    if (!any && !indexed) {
+      fprintf(fp, " 1,0,");	/* empty */
+      nSpans++;
+    }
+    fprintf(fp, " // row %d%s\n", row - rowMin, 
+	    folded && row + row != rowMin + rowMax ? " (mirrored)" : "");
+  }
+  fprintf(fp, "};\n\n");
+  if (indexed) {
+    int index = 0;
+    fprintf(fp, "static const u_int rowIndex[%d] = {\n", rowLast - rowMin + 2);
+    for (row = rowMin; row <= rowLast; row++) {
+      fprintf(fp, "    %d,\n", index);
+      index += countSpans(row, colMin, colMax);
+    }
+    fprintf(fp, "    %d\n};\n\n", index);
+  }
+  fprintf(fp, "const AbSpanTable %s = {\n", name);
+  fprintf(fp, "  abSpanTableGetBounds, abSpanTableCheck, abSpanTableRowSpans,\n");
+  fprintf(fp, "  %s, spans, %d, %d, %d, %d, %d\n};\n", 
+	  indexed ? "rowIndex" : "0", width, height, -colMin, -rowMin, folded);
+  fclose(fp);
+
+  if (indexed)			/* empty rows take no pair */
+    for (row = rowMin; row <= rowMax; row++)
+      if (!countSpans(row, colMin, colMax))
+	nSpansAll--;
+  fprintf(header, "extern const AbSpanTable %s;\n", name);
+  bytes = tableBytes(nSpans, indexed, rowLast - rowMin + 1);
+  unfoldedBytes = tableBytes(nSpansAll, indexed, height);
+  printf("%-16s %3dx%-3d %4d spans %5d bytes", name, width, height, nSpans, bytes);
+  if (folded)
+    printf(" (folded, saves %d)", unfoldedBytes - bytes);
+  printf("\n");
+  return bytes;
+}
+
+/* write the grid's width x height pixels (centered as a mask) as an 
+   AbBitmap in shapes/name.c, with its runs if runs; returns flash bytes */
+static int
+emitBitmap(const char *name, FILE *header, int width, int height, int runs)
+{
+  int colMin = -(width/2), rowMin = -(height/2), stride = (width + 7) / 8;
+  int col, row, nSpans = 0, bytes;
+  char filename[300];
+  FILE *fp;
+
+  checkOrigin(name, colMin, rowMin);
+  sprintf(filename, "shapes/%s.c", name);
+  fp = fopen(filename, "w");
+  assert(fp);
+  fprintf(fp, "// Automatically generated by makeShapes.\n");
+  fprintf(fp, "#include \"shape.h\"\n\n");
+  fprintf(fp, "static const u_char bits[%d] = {\n", stride * height);
+  for (row = rowMin; row < rowMin + height; row++) {
+    fprintf(fp, "   ");
+    for (col = 0; col < stride * 8; col += 8) {
+      int bit, byte = 0;
+      for (bit = 0; bit < 8; bit++)
+	if (col + bit < width && AT(colMin + col + bit, row))
+	  byte |= 0x80 >> bit;
+      fprintf(fp, " 0x%02x,", byte);
+    }
+    fprintf(fp, " // row %d\n", row - rowMin);
+  }
+  fprintf(fp, "};\n\n");
+  if (runs) {
+    int index = 0;
+    fprintf(fp, "static const u_char spans[] = {\n");
+    for (row = rowMin; row < rowMin + height; row++) {
+      fprintf(fp, "   ");
+      for (col = colMin; col < colMin + width; col++)
+	if (AT(col, row) && (col == colMin || !AT(col-1, row))) {
+	  int end = col;
+	  while (end < colMin + width - 1 && AT(end+1, row))
+	    end++;
+	  fprintf(fp, " %d,%d,", col - colMin, end - colMin);
+	  nSpans++;
+	}
+      fprintf(fp, " // row %d\n", row - rowMin);
+    }
+    fprintf(fp, "};\n\n");
+    fprintf(fp, "static const u_int rowIndex[%d] = {\n", height + 1);
+    for (row = rowMin; row < rowMin + height; row++) {
+      fprintf(fp, "    %d,\n", index);
+      index += countSpans(row, colMin, colMin + width - 1);
+    }
+    fprintf(fp, "    %d\n};\n\n", index);
+  }
+  fprintf(fp, "const AbBitmap %s = {\n", name);
+  fprintf(fp, "  abBitmapGetBounds, abBitmapCheck, abBitmapRowSpans,\n");
+  fprintf(fp, "  bits, %s, %d, %d, %d, %d\n};\n", 
+	  runs ? "rowIndex, spans" : "0, 0", width, height, -colMin, -rowMin);
+  fclose(fp);
+
+  fprintf(header, "extern const AbBitmap %s;\n", name);
+  bytes = stride * height + (runs ? 2 * nSpans + 2 * (height + 1) : 0) + 16;
+  printf("%-16s %3dx%-3d %4d spans %5d bytes (bitmap%s)\n", name, width, height, 
+	 nSpans, bytes, runs ? " and runs" : "");
+  return bytes;
+}
+
+int
+main(int argc, char **argv)
+{
+  FILE *desc, *header;
+  char line[300], guard[200], *g;
+  int lineNum = 0, total = 0;
+
+  if (argc != 3) {
+    fprintf(stderr, "usage: %s descFile header.h\n", argv[0]);
+    return 1;
+  }
+  desc = fopen(argv[1], "r");
+  header = fopen(argv[2], "w");
+  assert(desc); assert(header);
+  fprintf(header, "// Automatically generated by makeShapes from %s\n", argv[1]);
+  strncpy(guard, argv[2], sizeof guard - 1); /* header.h -> header_h */
+  guard[sizeof guard - 1] = 0;
+  for (g = guard; *g; g++)
+    if (!((*g >= 'a' && *g <= 'z') || (*g >= 'A' && *g <= 'Z') || (*g >= '0' && *g <= '9')))
+      *g = '_';
+  fprintf(header, "#ifndef %s_included\n#define %s_included\n\n", guard, guard);
+  fprintf(header, "#include \"shape.h\"\n\n");
+
+  while (fgets(line, sizeof line, desc)) {
+    char kind[32], name[200], dir[32], file[200];
+    int p[6], ok;
+    char *comment = strchr(line, '#');
+    lineNum++;
+    if (comment)
+      *comment = 0;
+    if (sscanf(line, "%31s %199s", kind, name) != 2)
+      continue;			/* blank */
+    memset(grid, 0, sizeof grid);
+    if (!strcmp(kind, "ellipse")) {
+      ok = sscanf(line, "%*s %*s %d %d", &p[0], &p[1]) == 2 
+	&& p[0] >= 0 && p[1] >= 0 && inRange(p[0]) && inRange(p[1]);
+      if (ok) rasterEllipse(p[0], p[1]);
+    } else if (!strcmp(kind, "rrect")) {
+      ok = sscanf(line, "%*s %*s %d %d %d", &p[0], &p[1], &p[2]) == 3 
+	&& inRange(p[0]) && inRange(p[1]) && p[2] >= 0 && p[2] <= p[0] && p[2] <= p[1];
+      if (ok) rasterRRect(p[0], p[1], p[2]);
+    } else if (!strcmp(kind, "triangle")) {
+      int v[3][2], i;
+      ok = sscanf(line, "%*s %*s %d %d %d %d %d %d", 
+		  &v[0][0], &v[0][1], &v[1][0], &v[1][1], &v[2][0], &v[2][1]) == 6;
+      for (i = 0; i < 3; i++)
+	ok = ok && inRange(v[i][0]) && inRange(v[i][1]);
+      if (ok) rasterTriangle(v);
+    } else if (!strcmp(kind, "arrow")) {
+      ok = sscanf(line, "%*s %*s %31s %d %d %d", dir, &p[0], &p[1], &p[2]) == 4
+	&& (!strcmp(dir, "right") || !strcmp(dir, "left") || !strcmp(dir, "up") || !strcmp(dir, "down"))
+	&& p[0] > 0 && p[0] <= MAX_DIM && p[1] >= 0 && p[1] <= p[0] && p[2] >= 0;
+      if (ok) rasterArrow(dir, p[0], p[1], p[2]);
+    } else if (!strcmp(kind, "mask")) {
+      ok = sscanf(line, "%*s %*s %d %d", &p[0], &p[1]) == 2 
+	&& p[0] > 0 && p[0] <= MAX_DIM && p[1] > 0 && p[1] <= MAX_DIM;
+      if (ok) {
+	ok = rasterMask(desc, p[0], p[1]);
+	lineNum += p[1];
+      }
+    } else if (!strcmp(kind, "bitmap")) {
+      int n = sscanf(line, "%*s %*s %199s %31s", file, dir);
+      ok = n >= 1 && (n == 1 || !strcmp(dir, "runs")) && rasterPbm(file, &p[0], &p[1]);
+      if (ok) {
+	total += emitBitmap(name, header, p[0], p[1], n == 2);
+	continue;
+      }
+    } else {
+      ok = 0;
+    }
+    if (!ok) {
+      fprintf(stderr, "%s:%d: bad shape description\n", argv[1], lineNum);
+      return 1;
+    }
+    total += emitTable(name, header);
+  }
+  fprintf(header, "\n#endif // included\n");
+  fclose(header);
+  printf("total %d bytes\n", total);
+  return 0;
+}
@@ -0,0 +1,75 @@
+/** \file spandemo.c
+ *  \brief Draws shapes compiled by makeShapes (see shapes.txt) as layers.
+ */
+#include <libTimer.h>
+#include <lcdutils.h>
+#include <lcddraw.h>
+#include "spanShapes.h"
+
+u_int bgColor = COLOR_BLUE;
+
+Layer heartMaskLayer = {	/**< the heart again, without its runs */
+  (AbShape *)&heartMask,
+  {screenWidth - 20, screenHeight - 20},
+  {0,0}, {0,0},				    /* last & next pos */
+  COLOR_PINK,
+  0
+};
+
+Layer heartLayer = {		/**< compiled from heart.pbm */
+  (AbShape *)&heart,
+  {20, screenHeight - 20},
+  {0,0}, {0,0},				    /* last & next pos */
+  COLOR_RED,
+  &heartMaskLayer
+};
+
+Layer invaderLayer = {
+  (AbShape *)&invader,
+  {screenWidth/2, 20},
+  {0,0}, {0,0},				    /* last & next pos */
+  COLOR_GREEN,
+  &heartLayer
+};
+
+Layer arrowLayer = {		/**< arrow tip on the button's edge */
+  (AbShape *)&upArrow,
+  {screenWidth/2, screenHeight/2 + 35},
+  {0,0}, {0,0},				    /* last & next pos */
+  COLOR_YELLOW,
+  &invaderLayer
+};
+
+Layer buttonLayer = {
+  (AbShape *)&button,
+  {screenWidth/2, screenHeight/2 + 30},
+  {0,0}, {0,0},				    /* last & next pos */
+  COLOR_GRAY,
+  &arrowLayer
+};
+
+Layer wedgeLayer = {
+  (AbShape *)&wedge,
+  {screenWidth/4 + 4, screenHeight/2 - 20},
+  {0,0}, {0,0},				    /* last & next pos */
+  COLOR_RED,
+  &buttonLayer
+};
+
+Layer ovalLayer = {		/**< on top */
+  (AbShape *)&oval20x12,
+  {screenWidth*3/4 - 4, screenHeight/2 - 20},
+  {0,0}, {0,0},				    /* last & next pos */
+  COLOR_ORANGE,
+  &wedgeLayer
+};
+
+int
+main()
+{
+  configureClocks();
+  lcd_init();
+
+  layerInit(&ovalLayer);
+  layerDraw(&ovalLayer);
+}
@@ -0,0 +1,50 @@
+#include "frameloop.h"
+#include "sr.h"
+
+volatile unsigned int frameStepsPending;
+unsigned int frameSteps, frameRenders, frameDrops;
+
+static unsigned char ticks, ticksPerStep; /* accumulated toward the next step */
+
+void
+frameLoopInit(unsigned char stepTicks)
+{
+  int gie = get_sr() & 8;
+  and_sr(~8);			/* GIE off */
+  ticksPerStep = stepTicks;
+  ticks = 0;
+  frameStepsPending = 0;
+  or_sr(gie);			/* GIE as it was */
+  frameSteps = frameRenders = frameDrops = 0;
+}
+
+void
+frameLoopTick()
+{
+  if (++ticks >= ticksPerStep) {
+    ticks = 0;
+    frameStepsPending++;
+  }
+}
+
+void
+frameLoopService(void (*step)(), void (*render)())
+{
+  unsigned int due;
+  int gie;
+  while (!frameStepsPending)
+    or_sr(0x10);		/* CPU off until the WDT handler wakes it */
+
+  gie = get_sr() & 8;
+  and_sr(~8);			/* GIE off: take every step due */
+  due = frameStepsPending;
+  frameStepsPending = 0;
+  or_sr(gie);			/* GIE as it was */
+
+  frameSteps += due;
+  frameDrops += due - 1;	/* only the last step is rendered */
+  while (due--)
+    step();
+  render();
+  frameRenders++;
+}
@@ -0,0 +1,38 @@
+#ifndef frameloop_included
+#define frameloop_included
+
+/** Fixed-timestep main loop.
+ *
+ *  The watchdog interrupt only counts time (frameLoopTick); the main
+ *  loop (frameLoopService) runs every simulation step that is due, then
+ *  renders once.  When rendering overruns, the steps that came due
+ *  meanwhile all run before the next render: frames are dropped, never 
+ *  simulation steps, so motion keeps its speed.
+ *
+ *  The WDT interrupt handler must call frameLoopTick() and wake the CPU
+ *  (clear CPUOFF in the saved SR) when frameStepsPending is nonzero.
+ */
+
+/** Simulation steps due but not yet run */
+extern volatile unsigned int frameStepsPending;
+
+/** Since frameLoopInit: steps run, frames rendered, and frames dropped
+ *  (steps not followed by their own render)
+ */
+extern unsigned int frameSteps, frameRenders, frameDrops;
+
+/** Start counting: one simulation step every ticksPerStep watchdog
+ *  interrupts (at 250 Hz)
+ */
+void frameLoopInit(unsigned char ticksPerStep);
+
+/** Call from the WDT interrupt handler */
+void frameLoopTick();
+
+/** Sleep (CPU off) until a step is due, run step() for each step due,
+ *  then render() once.  Interrupts must be enabled (GIE), so that the 
+ *  WDT handler can wake the CPU.
+ */
+void frameLoopService(void (*step)(), void (*render)());
+
+#endif // included
@@ -0,0 +1,41 @@
+#include <msp430.h>
+#include "stopwatch.h"
+
+static volatile unsigned int overflows; /* upper 16 bits of elapsed ticks */
+
+void stopwatchStart()
+{
+  TA1CTL = MC_0;		/* stop & reconfigure */
+  overflows = 0;
+  // Timer1 A control:
+  //  Timer clock source 2: system clock (SMCLK), divided by 8
+  //  Mode Control 2: continuously 0...0xffff, interrupt on overflow
+  TA1CTL = TASSEL_2 + ID_3 + MC_2 + TACLR + TAIE;
+}
+
+unsigned long stopwatchRead()
+{
+  unsigned int hi, lo;
+  do {				/* retry if an overflow happened between reads */
+    hi = overflows;
+    lo = TA1R;
+  } while (hi != overflows);
+  return ((unsigned long)hi << 16) | lo;
+}
+
+unsigned int stopwatchMs()
+{
+  return stopwatchRead() / (STOPWATCH_HZ / 1000);
+}
+
+void stopwatchStop()
+{
+  TA1CTL &= ~(MC_1 | MC_2);	/* halt, keep TA1R */
+}
+
+/* Timer1 overflow (TAIFG shares the TA1IV vector with CCR1 & CCR2) */
+void
+__interrupt_vec(TIMER1_A1_VECTOR) stopwatchOverflow(){
+  if (TA1IV == 0x0a)		/* reading TA1IV clears the flag */
+    overflows++;
+}
@@ -0,0 +1,22 @@
+#ifndef stopwatch_included
+#define stopwatch_included
+
+/** Stopwatch ticks per second: SMCLK (2MHz) / 8 */
+#define STOPWATCH_HZ 250000L
+
+/** Clear and start the stopwatch.  Uses Timer1_A (not used by the 
+ *  buzzer, which uses Timer0_A).  Requires interrupts (GIE) to count 
+ *  beyond 65535 ticks.
+ */
+void stopwatchStart();
+
+/** Elapsed ticks (1/STOPWATCH_HZ seconds) since stopwatchStart() */
+unsigned long stopwatchRead();
+
+/** Elapsed ms since stopwatchStart() (up to 65535) */
+unsigned int stopwatchMs();
+
+/** Stop counting.  stopwatchRead() keeps returning the stopped time. */
+void stopwatchStop();
+
+#endif // included